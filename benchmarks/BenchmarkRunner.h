@@ -0,0 +1,131 @@
+#ifndef BENCHMARK_RUNNER_H
+#define BENCHMARK_RUNNER_H
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <ostream>
+#include <string>
+
+/**
+ * Prevents the compiler from optimising away the computation of a value which is otherwise unused.
+ */
+template <typename T>
+inline void doNotOptimize(const T &value) {
+  asm volatile("" : : "r"(&value) : "memory");
+}
+
+/**
+ * Passed to a benchmark, which performs its work 'iterations' times and reports the number of items processed, e.g.
+ * cars. Only the time between resumeTiming() and pauseTiming() is measured, timing is running when the benchmark is
+ * called.
+ */
+class BenchmarkState {
+private:
+  using clock = std::chrono::steady_clock;
+  clock::time_point started;
+  double elapsed = 0; // s
+
+public:
+  const unsigned long iterations;
+  unsigned long items = 0;
+
+  explicit BenchmarkState(unsigned long _iterations) : iterations(_iterations) {}
+
+  void resumeTiming() { started = clock::now(); }
+  void pauseTiming() { elapsed += std::chrono::duration<double>(clock::now() - started).count(); }
+  double getElapsed() const { return elapsed; }
+};
+
+/**
+ * The parameters of a street benchmark, printed with its result.
+ */
+struct BenchmarkParameters {
+  unsigned int lanes;
+  double length; // m
+  unsigned int cars;
+  int laneOffset; // only used by the neighbor benchmarks
+};
+
+/**
+ * Runs benchmarks in the manner of Google Benchmark: the number of iterations is increased until the measured time
+ * exceeds the minimum time, then the time per iteration and per item is reported as a CSV or JSON row.
+ */
+class BenchmarkRunner {
+private:
+  std::ostream &out;
+  const bool json;
+  const double minTime; // s
+  const std::string filter;
+  bool firstRow = true;
+
+public:
+  /**
+   * @param      out      The stream the results are written to.
+   * @param[in]  json     Write the results as a JSON array instead of CSV.
+   * @param[in]  minTime  The minimum measured time of each benchmark in seconds.
+   * @param[in]  filter   Only benchmarks whose "structure/benchmark" name contains the filter are run.
+   */
+  BenchmarkRunner(std::ostream &_out, bool _json, double _minTime, const std::string &_filter)
+      : out(_out), json(_json), minTime(_minTime), filter(_filter) {
+    if (json) {
+      out << "[";
+    } else {
+      out << "structure,benchmark,lanes,length,cars,lane_offset,iterations,ns_per_iteration,ns_per_item\n";
+    }
+  }
+  ~BenchmarkRunner() {
+    if (json) out << "\n]\n";
+  }
+
+  template <typename Benchmark>
+  void run(const std::string &structure, const std::string &name, const BenchmarkParameters &parameters,
+      Benchmark &&benchmark) {
+    if ((structure + "/" + name).find(filter) == std::string::npos) return;
+
+    measure(benchmark, 1); // warm up
+    unsigned long iterations = 1;
+    while (true) {
+      const BenchmarkState state = measure(benchmark, iterations);
+      if (state.getElapsed() >= minTime || iterations >= 1000000000ul) {
+        writeRow(structure, name, parameters, state);
+        return;
+      }
+      // aim slightly beyond the minimum time, but grow by at most a factor of ten at once
+      const double factor = std::min(10.0, 1.4 * minTime / std::max(state.getElapsed(), 1e-9));
+      iterations          = std::max(iterations + 1, static_cast<unsigned long>(iterations * factor));
+    }
+  }
+
+private:
+  template <typename Benchmark>
+  static BenchmarkState measure(Benchmark &benchmark, unsigned long iterations) {
+    BenchmarkState state(iterations);
+    state.resumeTiming();
+    benchmark(state);
+    state.pauseTiming();
+    return state;
+  }
+
+  void writeRow(const std::string &structure, const std::string &name, const BenchmarkParameters &parameters,
+      const BenchmarkState &state) {
+    const double nsPerIteration = 1e9 * state.getElapsed() / state.iterations;
+    const double nsPerItem      = state.items > 0 ? 1e9 * state.getElapsed() / state.items : 0;
+    out << std::fixed << std::setprecision(3);
+    if (json) {
+      out << (firstRow ? "\n" : ",\n") << "  {\"structure\": \"" << structure << "\", \"benchmark\": \"" << name
+          << "\", \"lanes\": " << parameters.lanes << ", \"length\": " << parameters.length
+          << ", \"cars\": " << parameters.cars << ", \"lane_offset\": " << parameters.laneOffset
+          << ", \"iterations\": " << state.iterations << ", \"ns_per_iteration\": " << nsPerIteration
+          << ", \"ns_per_item\": " << nsPerItem << "}";
+    } else {
+      out << structure << "," << name << "," << parameters.lanes << "," << parameters.length << "," << parameters.cars
+          << "," << parameters.laneOffset << "," << state.iterations << "," << nsPerIteration << "," << nsPerItem
+          << "\n";
+    }
+    out.flush();
+    firstRow = false;
+  }
+};
+
+#endif
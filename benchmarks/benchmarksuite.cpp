@@ -0,0 +1,42 @@
+#include "BucketList.h"
+#include "CircularNaiveStreetDataStructure.h"
+#include "MergeNSkip.h"
+#include "NaiveStreetDataStructure.h"
+#include "lowlevelmodel/RfbStructureBenchmark.h"
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+/**
+ * Usage: benchmarksuite [--json] [--min-time s] [--filter name]
+ *
+ * Writes the results as CSV to stdout, or as JSON with --json. Each benchmark is repeated for at least 0.05 s by
+ * default, only benchmarks whose "structure/benchmark" name contains the filter are run.
+ */
+int main(int argc, char *argv[]) {
+  bool json      = false;
+  double minTime = 0.05;
+  std::string filter;
+  for (int i = 1; i < argc; ++i) {
+    const std::string argument(argv[i]);
+    if (argument == "--json") {
+      json = true;
+    } else if (argument == "--min-time" && i + 1 < argc) {
+      minTime = std::atof(argv[++i]);
+    } else if (argument == "--filter" && i + 1 < argc) {
+      filter = argv[++i];
+    } else {
+      std::cerr << "Usage: " << argv[0] << " [--json] [--min-time s] [--filter name]" << std::endl;
+      return 1;
+    }
+  }
+
+  BenchmarkRunner runner(std::cout, json, minTime, filter);
+  benchmarkRfbStructure<NaiveStreetDataStructure>(runner, "NaiveStreetDataStructure");
+  benchmarkRfbStructure<CircularNaiveStreetDataStructure>(runner, "CircularNaiveStreetDataStructure");
+  benchmarkRfbStructure<VectorBucketList>(runner, "VectorBucketList");
+  benchmarkRfbStructure<FreeListBucketList>(runner, "FreeListBucketList");
+  benchmarkRfbStructure<MergeNSkipLinear>(runner, "MergeNSkipLinear");
+  benchmarkRfbStructure<MergeNSkipCircular>(runner, "MergeNSkipCircular");
+  return 0;
+}
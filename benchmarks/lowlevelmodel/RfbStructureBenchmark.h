@@ -0,0 +1,149 @@
+#ifndef RFB_STRUCTURE_BENCHMARK_H
+#define RFB_STRUCTURE_BENCHMARK_H
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "../BenchmarkRunner.h"
+#include "LowLevelCar.h"
+
+/*
+ * Micro-benchmarks of the RfbStructure operations used in each simulation step:
+ * - insert_incorporate: inserting all cars into an empty street and incorporating them, per car
+ * - update_restore_consistency: moving all cars and restoring consistency, per car
+ * - next_car_in_front, next_car_behind: finding the neighbor of each car on the lane with the given offset, per car
+ * - iterate: iterating all cars, per car
+ * The cars are placed randomly with a fixed seed, i.e. all structures are measured on the same streets.
+ */
+
+struct BenchmarkCarPosition {
+  unsigned int lane;
+  double distance;
+};
+
+/**
+ * Random positions of the cars on a street, and positions after moving each car by a few meters, some of them to an
+ * adjacent lane. Moving the cars back and forth between the two position sets keeps them on the street.
+ */
+struct BenchmarkStreetPositions {
+  std::vector<BenchmarkCarPosition> initial;
+  std::vector<BenchmarkCarPosition> moved;
+
+  explicit BenchmarkStreetPositions(const BenchmarkParameters &parameters) {
+    std::mt19937 randomEngine(parameters.lanes * 100003 + parameters.cars);
+    std::uniform_int_distribution<unsigned int> laneDistribution(0, parameters.lanes - 1);
+    std::uniform_real_distribution<double> distanceDistribution(0, parameters.length);
+    std::uniform_real_distribution<double> moveDistribution(-10, 10);
+    std::uniform_real_distribution<double> laneChangeDistribution(0, 1);
+
+    for (unsigned int i = 0; i < parameters.cars; ++i) {
+      const BenchmarkCarPosition position{laneDistribution(randomEngine), distanceDistribution(randomEngine)};
+      BenchmarkCarPosition movedPosition = position;
+      movedPosition.distance = std::min(std::max(position.distance + moveDistribution(randomEngine), 0.0),
+          std::nextafter(parameters.length, 0.0));
+      if (parameters.lanes > 1 && laneChangeDistribution(randomEngine) < 0.1) {
+        movedPosition.lane = position.lane == 0 ? 1 : position.lane - 1;
+      }
+      initial.push_back(position);
+      moved.push_back(movedPosition);
+    }
+  }
+};
+
+template <class ConcreteStreet>
+void fillBenchmarkStreet(ConcreteStreet &street, const std::vector<BenchmarkCarPosition> &positions) {
+  for (unsigned int id = 0; id < positions.size(); ++id) {
+    street.insertCar(LowLevelCar(id, id, 0, 0, 0, 0, 0, 0, 0, positions[id].lane, positions[id].distance, 0));
+  }
+  street.incorporateInsertedCars();
+}
+
+template <template <typename Car> typename Street>
+void benchmarkRfbStructure(
+    BenchmarkRunner &runner, const std::string &structure, const BenchmarkParameters &parameters) {
+  const BenchmarkStreetPositions positions(parameters);
+
+  runner.run(structure, "insert_incorporate", parameters, [&](BenchmarkState &state) {
+    std::unique_ptr<Street<LowLevelCar>> street;
+    for (unsigned long i = 0; i < state.iterations; ++i) {
+      state.pauseTiming();
+      street.reset(new Street<LowLevelCar>(parameters.lanes, parameters.length));
+      state.resumeTiming();
+      fillBenchmarkStreet(*street, positions.initial);
+    }
+    state.items = state.iterations * parameters.cars;
+  });
+
+  runner.run(structure, "update_restore_consistency", parameters, [&](BenchmarkState &state) {
+    state.pauseTiming();
+    Street<LowLevelCar> street(parameters.lanes, parameters.length);
+    fillBenchmarkStreet(street, positions.initial);
+    state.resumeTiming();
+    for (unsigned long i = 0; i < state.iterations; ++i) {
+      const std::vector<BenchmarkCarPosition> &next = i % 2 == 0 ? positions.moved : positions.initial;
+      for (auto &car : street.allIterable()) {
+        const BenchmarkCarPosition &position = next[car.getId()];
+        car.setNext(position.lane, position.distance, 0);
+      }
+      street.updateCarsAndRestoreConsistency();
+    }
+    state.items = state.iterations * parameters.cars;
+  });
+
+  Street<LowLevelCar> street(parameters.lanes, parameters.length);
+  fillBenchmarkStreet(street, positions.initial);
+
+  for (int laneOffset = -1; laneOffset <= 1; ++laneOffset) {
+    if (laneOffset != 0 && parameters.lanes == 1) continue;
+    BenchmarkParameters neighborParameters = parameters;
+    neighborParameters.laneOffset          = laneOffset;
+
+    // cars whose lane with the offset does not exist are skipped
+    for (const bool inFront : {true, false}) {
+      runner.run(structure, inFront ? "next_car_in_front" : "next_car_behind", neighborParameters,
+          [&](BenchmarkState &state) {
+            auto iterable = street.allIterable();
+            for (unsigned long i = 0; i < state.iterations; ++i) {
+              for (auto carIt = iterable.begin(); carIt != iterable.end(); ++carIt) {
+                const int lane = int(carIt->getLane()) + laneOffset;
+                if (lane < 0 || lane >= int(parameters.lanes)) continue;
+                auto neighborIt =
+                    inFront ? street.getNextCarInFront(carIt, laneOffset) : street.getNextCarBehind(carIt, laneOffset);
+                doNotOptimize(neighborIt);
+                ++state.items;
+              }
+            }
+          });
+    }
+  }
+
+  runner.run(structure, "iterate", parameters, [&](BenchmarkState &state) {
+    double distanceSum = 0;
+    for (unsigned long i = 0; i < state.iterations; ++i) {
+      for (const auto &car : street.allIterable()) distanceSum += car.getDistance();
+    }
+    doNotOptimize(distanceSum);
+    state.items = state.iterations * parameters.cars;
+  });
+}
+
+/**
+ * Runs the benchmarks over streets with different lane counts, lengths and car densities.
+ */
+template <template <typename Car> typename Street>
+void benchmarkRfbStructure(BenchmarkRunner &runner, const std::string &structure) {
+  for (const unsigned int lanes : {1u, 3u}) {
+    for (const double length : {250.0, 1000.0}) {
+      for (const double density : {10.0, 50.0, 150.0}) { // cars per lane and km
+        const unsigned int cars = density * lanes * length / 1000;
+        benchmarkRfbStructure<Street>(runner, structure, BenchmarkParameters{lanes, length, cars, 0});
+      }
+    }
+  }
+}
+
+#endif
@@ -0,0 +1 @@
+/root/miniconda/include/nlohmann/json.hpp
\ No newline at end of file
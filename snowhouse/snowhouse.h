@@ -0,0 +1,25 @@
+// LOCAL STUB - not part of the repository
+#pragma once
+#include <algorithm>
+#include <sstream>
+#include <string>
+namespace snowhouse {
+struct AssertionException {
+  std::string msg;
+  AssertionException(std::string m) : msg(m) {}
+  std::string GetMessage() const { return msg; }
+};
+struct ExprEq { bool neg; template <class T> struct Eq { bool neg; T v; }; template <class T> Eq<T> EqualTo(T v) { return {neg, v}; }
+  template <class T> struct Cont { bool neg; T v; }; template <class T> Cont<T> Containing(T v) { return {neg, v}; }
+  struct Tr { bool neg; }; Tr True() { return {neg}; } ExprEq Not() { return {!neg}; } };
+inline ExprEq Is() { return {false}; }
+template <class A, class T> void AssertThatImpl(const A &a, ExprEq::Eq<T> e, const char *f, int l) {
+  if ((a == e.v) == e.neg) { std::stringstream s; s << "Expected equality failed at " << f << ":" << l << "\n"; throw AssertionException(s.str()); } }
+template <class A, class T> void AssertThatImpl(const A &a, ExprEq::Cont<T> e, const char *f, int l) {
+  bool c = std::find(a.begin(), a.end(), e.v) != a.end();
+  if (c == e.neg) { std::stringstream s; s << "Expected containing failed at " << f << ":" << l << "\n"; throw AssertionException(s.str()); } }
+template <class A> void AssertThatImpl(const A &a, ExprEq::Tr e, const char *f, int l) {
+  if (bool(a) == e.neg) { std::stringstream s; s << "Expected true failed at " << f << ":" << l << "\n"; throw AssertionException(s.str()); } }
+}
+#define AssertThat(a, e) snowhouse::AssertThatImpl((a), (e), __FILE__, __LINE__)
+#define AssertThrows(E, x) do { bool t = false; try { x; } catch (const E &) { t = true; } if (!t) throw snowhouse::AssertionException("no throw"); } while (0)
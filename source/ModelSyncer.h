@@ -1,11 +1,20 @@
 #ifndef MODEL_SYNCER_H
 #define MODEL_SYNCER_H
 
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <istream>
+#include <memory>
+#include <ostream>
 #include <vector>
 
+#include "BinaryScenarioFormat.h"
 #include "BucketList.h"
+#include "CheckpointFile.h"
 #include "DomainModel.h"
 #include "LowLevelCar.h"
+#include "RoutingTable.h"
 #include "SimulationData.h"
 
 #define VEHICLE_LENGTH 5.0
@@ -19,6 +28,18 @@ private:
 private:
   Data &data;
 
+  template <typename Record>
+  static void writeTable(std::ostream &out, const std::vector<Record> &table) {
+    out.write(reinterpret_cast<const char *>(table.data()), table.size() * sizeof(Record));
+  }
+
+  template <typename Record>
+  static std::vector<Record> readTable(std::istream &in, std::size_t size) {
+    std::vector<Record> table(size);
+    in.read(reinterpret_cast<char *>(table.data()), size * sizeof(Record));
+    return table;
+  }
+
   /**
    * @brief      Sets a signal of the low level street correlating to a specific domain model street.
    */
@@ -28,6 +49,15 @@ private:
   }
 
 public:
+  /**
+   * A copy of the low level streets including their cars and the routing table built for them. The routing table only
+   * depends on the street network and the routes, it is shared by all simulations restored from the snapshot.
+   */
+  struct Snapshot {
+    std::vector<LowLevelStreet<RfbStructure>> streets;
+    std::shared_ptr<const RoutingTable> routingTable;
+  };
+
   ModelSyncer(Data &_data) : data(_data) {}
 
   void buildFreshLowLevel() {
@@ -38,39 +68,84 @@ public:
 
     // Clear streets, start fresh
     streets.clear();
+    data.setRoutingTable(std::make_shared<const RoutingTable>(domainModel));
 
     // Compute optimal bucket section length as '2 * total street length / total car count'
     if (domainModel.getVehicles().size() > 0) {
       unsigned long totalStreetLength = 0;
-      for (const auto &street : domainModel.getStreets()) { totalStreetLength += street->getLength(); }
+      for (const auto &street : domainModel.getStreets()) { totalStreetLength += street.getLength(); }
       BucketListSectionLength = 2 * totalStreetLength / domainModel.getVehicles().size();
     }
 
     for (const auto &domainStreet : domainModel.getStreets()) {
-      streets.emplace_back(domainStreet->getId(), domainStreet->getLanes(), domainStreet->getLength(),
-          domainStreet->getSpeedLimit(), trafficLightCar, TRAFFIC_LIGHT_OFFSET);
+      streets.emplace_back(domainStreet.getId(), domainStreet.getLanes(), domainStreet.getLength(),
+          domainStreet.getSpeedLimit(), trafficLightCar, TRAFFIC_LIGHT_OFFSET);
     }
 
     for (const auto &domainVehicle : domainModel.getVehicles()) {
       const double accelerationDivisor =
-          2.0 * std::sqrt(domainVehicle->getMaxAcceleration() * domainVehicle->getTargetDeceleration());
+          2.0 * std::sqrt(domainVehicle.getMaxAcceleration() * domainVehicle.getTargetDeceleration());
 
-      LowLevelCar car(domainVehicle->getId(), domainVehicle->getExternalId(), domainVehicle->getTargetVelocity(),
-          domainVehicle->getMaxAcceleration(), accelerationDivisor, domainVehicle->getMinDistance(),
-          domainVehicle->getTargetHeadway(), domainVehicle->getPoliteness(), VEHICLE_LENGTH,
-          domainVehicle->getPosition().getLane(), domainVehicle->getPosition().getDistance());
+      LowLevelCar car(domainVehicle.getId(), domainVehicle.getExternalId(), domainVehicle.getTargetVelocity(),
+          domainVehicle.getMaxAcceleration(), accelerationDivisor, domainVehicle.getMinDistance(),
+          domainVehicle.getTargetHeadway(), domainVehicle.getPoliteness(), VEHICLE_LENGTH,
+          domainVehicle.getPosition().getLane(), domainVehicle.getPosition().getDistance());
+      car.setRouteIndex(domainVehicle.getDirectionIndex());
 
-      auto &street = streets.at(domainVehicle->getPosition().getStreet()->getId());
+      auto &street = streets.at(domainVehicle.getPosition().getStreet()->getId());
 
       street.insertCar(car);
     }
 
     for (auto &street : streets) { street.incorporateInsertedCars(); }
 
-    // Init signals on low level streets:
+    initialiseLowLevelSignals();
+  }
+
+  /**
+   * @brief      Restores the low level streets from a snapshot previously taken of a freshly built low level model.
+   * In contrast to buildFreshLowLevel(), no cars are inserted and no sorting is required, each street's car storage is
+   * copied as a whole and the routing table is reused. The signals are re-initialised from the domain model as its
+   * signal plan may have changed.
+   * @param[in]  snapshot  The low level model as returned by takeSnapshot().
+   */
+  void restoreLowLevel(const Snapshot &snapshot) {
+    auto &streets = data.getStreets();
+
+    streets.clear();
+    streets.reserve(snapshot.streets.size());
+    for (const auto &street : snapshot.streets) { streets.emplace_back(street); }
+    data.setRoutingTable(snapshot.routingTable);
+    // the domain model may hold the positions of a later step
+    for (auto &street : streets) {
+      for (auto &car : street.allIterable()) { car.setPositionChanged(true); }
+    }
+
+    initialiseLowLevelSignals();
+  }
+
+  /**
+   * @brief      Takes a snapshot of the low level model which can be restored using restoreLowLevel().
+   * @return     A copy of all low level streets including their cars, sharing the routing table.
+   */
+  Snapshot takeSnapshot() const {
+    Snapshot snapshot;
+    snapshot.streets.reserve(data.getStreets().size());
+    for (const auto &street : data.getStreets()) { snapshot.streets.emplace_back(street); }
+    snapshot.routingTable = data.getSharedRoutingTable();
+    return snapshot;
+  }
+
+  /**
+   * @brief      Sets the signals of all low level streets according to the current signals of the domain model
+   * junctions.
+   */
+  void initialiseLowLevelSignals() {
+    auto &domainModel = data.getDomainModel();
+
     for (const auto &domainJunction : domainModel.getJunctions()) {
-      Junction::Signal currentSignal = domainJunction->getCurrentSignal();
-      for (const auto &connectedStreet : domainJunction->getIncomingStreets()) {
+      Junction::Signal currentSignal = domainJunction.getCurrentSignal();
+      for (const auto &connectedStreet : domainJunction.getIncomingStreets()) {
         if (connectedStreet.isConnected()) {
           if (connectedStreet.getDirection() == currentSignal.getDirection()) {
             setLowLevelSignal(Signal::GREEN, connectedStreet.getStreet());
@@ -82,15 +157,183 @@ public:
     }
   }
 
-  void writeVehiclePositionToDomainModel() {
-    auto &domainModel = data.getDomainModel();
+  /**
+   * @brief      Appends the current positions of all vehicles to the given records, in the order of the streets. The
+   * domain model is not changed.
+   */
+  void captureVehiclePositions(std::vector<BinaryScenarioFormat::VehiclePositionRecord> &positions) const {
+    const auto &domainModel = data.getDomainModel();
 
     for (const auto &street : data.getStreets()) {
-      auto &domainStreet = domainModel.getStreet(street.getId());
+      const auto &domainStreet = domainModel.getStreet(street.getId());
+      const int32_t from       = domainStreet.getSourceJunction().getExternalId();
+      const int32_t to         = domainStreet.getTargetJunction().getExternalId();
 
       for (const auto &car : street.allIterable()) {
-        auto &domainVehicle = domainModel.getVehicle(car.getId());
-        domainVehicle.setPosition(domainStreet, car.getLane(), car.getDistance());
+        positions.push_back(BinaryScenarioFormat::VehiclePositionRecord{
+            static_cast<int32_t>(car.getExternalId()), from, to, car.getLane(), car.getDistance()});
+      }
+    }
+  }
+
+  /**
+   * @brief      Writes the complete dynamic state of the simulation: the cars of the low level streets, the signals of
+   * the streets and junctions and the route indices of the vehicles. Together with the scenario it allows to continue
+   * the simulation exactly, see restoreCheckpoint().
+   * @param      out   The stream to write to.
+   * @param[in]  step  The number of steps performed so far.
+   */
+  void writeCheckpoint(std::ostream &out, unsigned int step) const {
+    using Format            = BinaryScenarioFormat;
+    const auto &domainModel = data.getDomainModel();
+
+    std::vector<Format::JunctionStateRecord> junctions;
+    junctions.reserve(domainModel.getJunctions().size());
+    for (const auto &junction : domainModel.getJunctions()) {
+      junctions.push_back(Format::JunctionStateRecord{junction.getSignalIndex(), junction.getCurrentTimer()});
+    }
+
+    std::vector<Format::StreetStateRecord> streets;
+    std::vector<Format::CarStateRecord> cars;
+    streets.reserve(data.getStreets().size());
+    cars.reserve(domainModel.getVehicles().size());
+    for (const auto &street : data.getStreets()) {
+      const std::size_t firstCar = cars.size();
+      for (const auto &car : street.allIterable()) {
+        cars.push_back(Format::CarStateRecord{
+            car.getId(), car.getLane(), car.getDistance(), car.getVelocity(), car.getTravelDistance()});
+      }
+      streets.push_back(
+          Format::StreetStateRecord{static_cast<uint32_t>(street.getSignal()), uint32_t(cars.size() - firstCar)});
+    }
+
+    // the route indices are kept in the low level cars while simulating
+    std::vector<Format::RouteIndexRecord> routeIndices(domainModel.getVehicles().size());
+    for (const auto &street : data.getStreets()) {
+      for (const auto &car : street.allIterable()) { routeIndices[car.getId()] = car.getRouteIndex(); }
+    }
+
+    Format::CheckpointHeader header = {};
+    std::memcpy(header.magic, Format::checkpointMagic, sizeof(Format::checkpointMagic));
+    header.version                 = Format::version;
+    header.step                    = step;
+    header.junctionCount           = junctions.size();
+    header.streetCount             = streets.size();
+    header.vehicleCount            = routeIndices.size();
+    header.carCount                = cars.size();
+    header.bucketListSectionLength = BucketListSectionLength;
+
+    out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    writeTable(out, junctions);
+    writeTable(out, streets);
+    writeTable(out, cars);
+    writeTable(out, routeIndices);
+  }
+
+  /**
+   * @brief      Builds the low level streets from a checkpoint written by writeCheckpoint() instead of the domain model
+   * and restores the signals and route indices. The domain model must have been read from the same scenario.
+   * @param      in    The stream to read the checkpoint from.
+   * @return     The number of steps performed before the checkpoint.
+   */
+  unsigned int restoreCheckpoint(std::istream &in) {
+    using Format      = BinaryScenarioFormat;
+    auto &streets     = data.getStreets();
+    auto &domainModel = data.getDomainModel();
+
+    if (!Format::isHostLittleEndian())
+      throw CheckpointFile::Exception("Checkpoints are only supported on little-endian hosts.");
+
+    Format::CheckpointHeader header;
+    in.read(reinterpret_cast<char *>(&header), sizeof(header));
+    if (!in || std::memcmp(header.magic, Format::checkpointMagic, sizeof(Format::checkpointMagic)) != 0)
+      throw CheckpointFile::Exception("Input is not a checkpoint.");
+    if (header.version != Format::version)
+      throw CheckpointFile::Exception("Unsupported version of the checkpoint format.");
+    if (header.junctionCount != domainModel.getJunctions().size() ||
+        header.streetCount != domainModel.getStreets().size() ||
+        header.vehicleCount != domainModel.getVehicles().size() || header.carCount != header.vehicleCount)
+      throw CheckpointFile::Exception("The checkpoint does not belong to the scenario.");
+
+    const auto junctionStates = readTable<Format::JunctionStateRecord>(in, header.junctionCount);
+    const auto streetStates   = readTable<Format::StreetStateRecord>(in, header.streetCount);
+    const auto cars           = readTable<Format::CarStateRecord>(in, header.carCount);
+    const auto routeIndices   = readTable<Format::RouteIndexRecord>(in, header.vehicleCount);
+    if (!in) throw CheckpointFile::Exception("Checkpoint is truncated.");
+
+    for (std::size_t i = 0; i < header.junctionCount; ++i) {
+      domainModel.getJunction(i).restoreSignalState(junctionStates[i].signalIndex, junctionStates[i].currentTimer);
+    }
+    for (std::size_t i = 0; i < header.vehicleCount; ++i) {
+      domainModel.getVehicle(i).restoreDirectionIndex(routeIndices[i]);
+    }
+
+    LowLevelCar trafficLightCar(0, 0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0);
+    BucketListSectionLength = header.bucketListSectionLength;
+
+    streets.clear();
+    streets.reserve(header.streetCount);
+    data.setRoutingTable(std::make_shared<const RoutingTable>(domainModel));
+    // there are as many cars as vehicles, i.e. each vehicle is restored exactly once if none is restored twice
+    std::vector<bool> isRestored(header.vehicleCount, false);
+    std::size_t car = 0;
+    for (std::size_t i = 0; i < header.streetCount; ++i) {
+      const auto &domainStreet = domainModel.getStreet(i);
+      streets.emplace_back(domainStreet.getId(), domainStreet.getLanes(), domainStreet.getLength(),
+          domainStreet.getSpeedLimit(), trafficLightCar, TRAFFIC_LIGHT_OFFSET);
+      auto &street = streets.back();
+
+      if (streetStates[i].signal > GREEN) throw CheckpointFile::Exception("Invalid signal in checkpoint.");
+      if (car + streetStates[i].carCount > cars.size())
+        throw CheckpointFile::Exception("Invalid car count in checkpoint.");
+      for (const std::size_t end = car + streetStates[i].carCount; car < end; ++car) {
+        const auto &state = cars[car];
+        if (state.vehicle >= header.vehicleCount || state.lane >= domainStreet.getLanes() ||
+            !(state.distance >= 0 && state.distance <= domainStreet.getLength()))
+          throw CheckpointFile::Exception("Invalid car in checkpoint.");
+        if (isRestored[state.vehicle]) throw CheckpointFile::Exception("Duplicate car in checkpoint.");
+        isRestored[state.vehicle] = true;
+
+        const auto &domainVehicle = domainModel.getVehicle(state.vehicle);
+        const double accelerationDivisor =
+            2.0 * std::sqrt(domainVehicle.getMaxAcceleration() * domainVehicle.getTargetDeceleration());
+        LowLevelCar lowLevelCar(domainVehicle.getId(), domainVehicle.getExternalId(),
+            domainVehicle.getTargetVelocity(), domainVehicle.getMaxAcceleration(), accelerationDivisor,
+            domainVehicle.getMinDistance(), domainVehicle.getTargetHeadway(), domainVehicle.getPoliteness(),
+            VEHICLE_LENGTH, state.lane, state.distance, state.velocity, state.travelDistance);
+        lowLevelCar.setRouteIndex(domainVehicle.getDirectionIndex());
+        street.insertCar(lowLevelCar);
+      }
+      // the cars are sorted by compareLess, a total order, i.e. they end up in the same order as before
+      street.incorporateInsertedCars();
+      street.setSignal(static_cast<Signal>(streetStates[i].signal));
+    }
+
+    return header.step;
+  }
+
+  /**
+   * @brief      Writes the positions of the low level cars back to the domain model.
+   *
+   * Only vehicles whose low level car has been moved by LowLevelCar::update() since the last write-back are touched,
+   * e.g. cars waiting at a red light are skipped. Each car is on exactly one street, so the streets are processed in
+   * parallel.
+   */
+  void writeVehiclePositionToDomainModel() {
+    auto &domainStreets  = data.getDomainModel().getStreets();
+    auto &domainVehicles = data.getDomainModel().getVehicles();
+    auto &streets        = data.getStreets();
+
+#pragma omp parallel for shared(domainStreets, domainVehicles, streets) schedule(static)
+    for (std::size_t i = 0; i < streets.size(); ++i) {
+      auto &street       = streets[i];
+      auto &domainStreet = domainStreets[street.getId()];
+
+      for (auto &car : street.allIterable()) {
+        if (!car.hasPositionChanged()) continue;
+        auto &domainVehicle = domainVehicles[car.getId()];
+        domainVehicle.updatePosition(domainStreet, car.getLane(), car.getDistance(), car.getRouteIndex());
+        car.setPositionChanged(false);
       }
     }
   }
@@ -0,0 +1,63 @@
+#include "PerfCounters.h"
+
+#include <cerrno>
+#include <cstring>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+bool PerfCounters::open(std::string &error) {
+#ifdef __linux__
+  const uint64_t configs[COUNTER_COUNT] = {PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS,
+      PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES};
+  bool anyOpen = false;
+  for (int counter = 0; counter < COUNTER_COUNT; ++counter) {
+    perf_event_attr attributes;
+    std::memset(&attributes, 0, sizeof(attributes));
+    attributes.size           = sizeof(attributes);
+    attributes.type           = PERF_TYPE_HARDWARE;
+    attributes.config         = configs[counter];
+    attributes.exclude_kernel = 1;
+    attributes.exclude_hv     = 1;
+    attributes.inherit        = 1;
+    attributes.read_format    = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+    // the calling process on any cpu, without a group: inherited counters cannot be read as a group
+    descriptors[counter] = syscall(SYS_perf_event_open, &attributes, 0, -1, -1, 0);
+    if (descriptors[counter] >= 0) {
+      anyOpen = true;
+    } else if (error.empty()) {
+      error = std::strerror(errno);
+    }
+  }
+  return anyOpen;
+#else
+  error = "perf_event_open is only available on Linux";
+  return false;
+#endif
+}
+
+PerfCounters::Values PerfCounters::read() {
+  Values values = {};
+#ifdef __linux__
+  for (int counter = 0; counter < COUNTER_COUNT; ++counter) {
+    uint64_t data[3]; // value, time enabled, time running
+    if (descriptors[counter] < 0 || ::read(descriptors[counter], data, sizeof(data)) != sizeof(data)) continue;
+    values[counter] = data[2] > 0 && data[2] < data[1] ? uint64_t(double(data[0]) * data[1] / data[2]) : data[0];
+  }
+#endif
+  return values;
+}
+
+const char *PerfCounters::getName(Counter counter) {
+  switch (counter) {
+  case CYCLES: return "cycles";
+  case INSTRUCTIONS: return "instructions";
+  case LLC_MISSES: return "llc_misses";
+  case BRANCH_MISSES: return "branch_misses";
+  default: return "";
+  }
+}
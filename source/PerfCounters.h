@@ -0,0 +1,41 @@
+#ifndef PERF_COUNTERS_H
+#define PERF_COUNTERS_H
+
+#include <array>
+#include <cstdint>
+#include <string>
+
+/**
+ * Hardware performance counters of the process, read through the Linux perf_event_open interface.
+ *
+ * The counters only count in user space. They are inherited by the threads created after opening them, i.e. they must
+ * be opened before the first parallel region, and reading them returns the sum over all threads. If the hardware has
+ * fewer counters than requested, the kernel multiplexes them and the values are extrapolated from the time each counter
+ * was active.
+ */
+class PerfCounters {
+public:
+  enum Counter { CYCLES, INSTRUCTIONS, LLC_MISSES, BRANCH_MISSES, COUNTER_COUNT };
+  using Values = std::array<uint64_t, COUNTER_COUNT>;
+
+private:
+  static inline std::array<int, COUNTER_COUNT> descriptors = {-1, -1, -1, -1};
+
+public:
+  /**
+   * @brief      Opens all counters available on this machine.
+   * @param[out] error  The reason if no counter could be opened.
+   * @return     True if at least one counter is open.
+   */
+  static bool open(std::string &error);
+  static bool isOpen(Counter counter) { return descriptors[counter] >= 0; }
+
+  /**
+   * @brief      Reads the current values, counters which are not open read as 0.
+   */
+  static Values read();
+
+  static const char *getName(Counter counter);
+};
+
+#endif
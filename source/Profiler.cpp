@@ -0,0 +1,184 @@
+#include "Profiler.h"
+
+#include <algorithm>
+#include <cstring>
+#include <iomanip>
+#include <map>
+#include <string>
+#include <utility>
+
+void Profiler::registerThread() {
+  std::lock_guard<std::mutex> lock(registryMutex);
+  threadLogs.emplace_back(new ThreadLog{static_cast<unsigned int>(threadLogs.size()), {}});
+  threadLog = threadLogs.back().get();
+}
+
+double Profiler::getTicksPerMicrosecond() {
+  const uint64_t ticks = now() - enabledTimestamp;
+  const double microseconds =
+      std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - enabledTime).count();
+  return microseconds > 0 ? ticks / microseconds : 1.0;
+}
+
+void Profiler::enable(Level _level) {
+  enabledTime      = std::chrono::steady_clock::now();
+  enabledTimestamp = now();
+  level            = _level;
+}
+
+bool Profiler::enableCounters(unsigned int window, std::ostream &report, std::string &error) {
+  if (!PerfCounters::open(error)) return false;
+  countingThread = true;
+  counterWindow  = window;
+  counterReport  = &report;
+  return true;
+}
+
+int Profiler::beginCounting(const char *name) {
+  int slot = 0;
+  while (slot < int(counterSlots.size()) && std::strcmp(counterSlots[slot].name, name) != 0) ++slot;
+  if (slot == int(counterSlots.size())) counterSlots.push_back(CounterSlot{name, depth, {}, {}});
+  counterSlots[slot].start = PerfCounters::read();
+  return slot;
+}
+
+void Profiler::endCounting(int slot) {
+  const PerfCounters::Values end = PerfCounters::read();
+  CounterSlot &counterSlot       = counterSlots[slot];
+  for (int counter = 0; counter < PerfCounters::COUNTER_COUNT; ++counter) {
+    counterSlot.total[counter] += end[counter] - counterSlot.start[counter];
+  }
+
+  if (depth == 0 && ++windowSteps == counterWindow) printCounterWindow();
+}
+
+void Profiler::printCounterWindow() {
+  std::ostream &out = *counterReport;
+  out << "steps " << countedSteps + 1 << "-" << countedSteps + windowSteps << ":\n";
+  for (int counter = 0; counter < PerfCounters::COUNTER_COUNT; ++counter) {
+    out << std::setw(18) << PerfCounters::getName(PerfCounters::Counter(counter));
+  }
+  out << std::setw(10) << "ipc" << std::setw(12) << "llc_mpki" << "  description\n";
+
+  out << std::fixed << std::setprecision(3);
+  for (CounterSlot &slot : counterSlots) {
+    for (int counter = 0; counter < PerfCounters::COUNTER_COUNT; ++counter) {
+      if (PerfCounters::isOpen(PerfCounters::Counter(counter))) {
+        out << std::setw(18) << slot.total[counter];
+      } else {
+        out << std::setw(18) << "n/a";
+      }
+    }
+    // instructions per cycle and last level cache misses per thousand instructions
+    const double instructions = slot.total[PerfCounters::INSTRUCTIONS];
+    const uint64_t cycles     = slot.total[PerfCounters::CYCLES];
+    if (PerfCounters::isOpen(PerfCounters::INSTRUCTIONS) && PerfCounters::isOpen(PerfCounters::CYCLES)) {
+      out << std::setw(10) << (cycles > 0 ? instructions / cycles : 0);
+    } else {
+      out << std::setw(10) << "n/a";
+    }
+    if (PerfCounters::isOpen(PerfCounters::INSTRUCTIONS) && PerfCounters::isOpen(PerfCounters::LLC_MISSES)) {
+      out << std::setw(12) << (instructions > 0 ? 1000 * slot.total[PerfCounters::LLC_MISSES] / instructions : 0);
+    } else {
+      out << std::setw(12) << "n/a";
+    }
+    out << "  " << std::string(2 * slot.depth, ' ') << slot.name << "\n";
+    slot.total = {};
+  }
+  out.flush();
+
+  countedSteps += windowSteps;
+  windowSteps = 0;
+}
+
+void Profiler::writeChromeTrace(std::ostream &out) {
+  const double ticksPerMicrosecond = getTicksPerMicrosecond();
+  std::lock_guard<std::mutex> lock(registryMutex);
+
+  out << "{\"traceEvents\":[\n";
+  bool first = true;
+  out << std::fixed << std::setprecision(3);
+  for (const auto &log : threadLogs) {
+    out << (first ? "" : ",\n") << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << log->thread
+        << ",\"args\":{\"name\":\"thread " << log->thread << "\"}}";
+    first = false;
+
+    for (const auto &event : log->events) {
+      out << ",\n{\"name\":\"" << event.name << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << log->thread
+          << ",\"ts\":" << (event.start - enabledTimestamp) / ticksPerMicrosecond
+          << ",\"dur\":" << (event.end - event.start) / ticksPerMicrosecond;
+      if (event.argument >= 0) out << ",\"args\":{\"id\":" << event.argument << "}";
+      out << "}";
+    }
+  }
+  out << "\n]}\n";
+}
+
+std::vector<Profiler::ZoneSummary> Profiler::summarize() {
+  const double ticksPerMicrosecond = getTicksPerMicrosecond();
+  std::lock_guard<std::mutex> lock(registryMutex);
+
+  struct ZoneTicks {
+    uint64_t firstStart     = UINT64_MAX;
+    unsigned int depth      = 0;
+    unsigned long callCount = 0;
+    std::map<unsigned int, uint64_t> ticksPerThread;
+  };
+  // Zones opened by worker threads of a parallel loop do not know the zones of the thread starting the loop, i.e. their
+  // depth is too low. That thread takes part in the loop as well, so the highest depth of a zone is the correct one.
+  std::map<std::string, ZoneTicks> zones;
+  for (const auto &log : threadLogs) {
+    for (const auto &event : log->events) {
+      ZoneTicks &zone = zones[event.name];
+      zone.firstStart = std::min(zone.firstStart, event.start);
+      zone.depth      = std::max(zone.depth, event.depth);
+      zone.callCount += 1;
+      zone.ticksPerThread[log->thread] += event.end - event.start;
+    }
+  }
+
+  // in the order the zones were first entered, which lists nested zones below the zone containing them
+  std::vector<std::pair<const std::string, ZoneTicks> *> orderedZones;
+  for (auto &zone : zones) orderedZones.push_back(&zone);
+  std::sort(orderedZones.begin(), orderedZones.end(), [](const auto *a, const auto *b) {
+    return a->second.firstStart != b->second.firstStart ? a->second.firstStart < b->second.firstStart
+                                                        : a->second.depth < b->second.depth;
+  });
+
+  std::vector<ZoneSummary> summaries;
+  for (const auto *zone : orderedZones) {
+    uint64_t totalTicks     = 0;
+    uint64_t maxThreadTicks = 0;
+    for (const auto &thread : zone->second.ticksPerThread) {
+      totalTicks += thread.second;
+      maxThreadTicks = std::max(maxThreadTicks, thread.second);
+    }
+    summaries.push_back(ZoneSummary{zone->first, zone->second.depth, zone->second.callCount,
+        static_cast<unsigned int>(zone->second.ticksPerThread.size()), totalTicks / ticksPerMicrosecond,
+        maxThreadTicks / ticksPerMicrosecond});
+  }
+  return summaries;
+}
+
+void Profiler::printSummary(std::ostream &out) {
+  // the remaining steps of the last, incomplete window
+  if (windowSteps > 0) printCounterWindow();
+
+  out << std::setw(15) << "call_count" << std::setw(20) << "total_time_us" << std::setw(15) << "avg_time_us"
+      << std::setw(10) << "threads" << std::setw(20) << "max_thread_time_us" << std::setw(12) << "imbalance"
+      << "  description\n";
+  out << std::fixed << std::setprecision(3);
+  for (const ZoneSummary &zone : summarize()) {
+    // the busiest thread relative to an even distribution, 1 is perfectly balanced
+    const double imbalance = zone.totalTime > 0 ? zone.maxThreadTime * zone.threads / zone.totalTime : 1;
+
+    out << std::setw(15) << zone.callCount << std::setw(20) << zone.totalTime << std::setw(15)
+        << zone.totalTime / zone.callCount << std::setw(10) << zone.threads << std::setw(20) << zone.maxThreadTime
+        << std::setw(12) << imbalance << "  " << std::string(2 * zone.depth, ' ') << zone.name << "\n";
+  }
+}
+
+void Profiler::clear() {
+  std::lock_guard<std::mutex> lock(registryMutex);
+  for (auto &log : threadLogs) log->events.clear();
+}
@@ -0,0 +1,199 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+#include "PerfCounters.h"
+
+/**
+ * Records the time spent in nested zones of the simulation, separately for each thread.
+ *
+ * A zone is the lifetime of a Profiler::Zone object, zones opened while another one is open on the same thread are
+ * nested in it. Profiling is disabled by default and enabled at runtime, a disabled zone costs a single comparison.
+ * Each thread appends the zones it has completed to its own log, i.e. recording needs no synchronization. The logs are
+ * only read once the simulation is over, either as a trace in the Chrome trace event format (viewable in
+ * chrome://tracing or Perfetto) or as a summary showing the total time per zone and its distribution across threads.
+ *
+ * Zones are summarized by name, i.e. each place opening a zone should use a name of its own.
+ *
+ * Timestamps are taken from the time stamp counter where available and converted to time using the steady clock.
+ *
+ * Optionally the hardware performance counters are read at the start and end of each phase zone opened by the thread
+ * enabling them, which covers the work of all threads within the phase. The counts are summed per zone and printed
+ * every few steps, a step being a zone which is not nested in another one.
+ */
+class Profiler {
+public:
+  enum Level {
+    OFF     = 0,
+    PHASES  = 1, // the phases of each step
+    STREETS = 2, // additionally the work on each street, produces a lot of zones
+  };
+
+  /**
+   * The time spent in all zones with the same name.
+   */
+  struct ZoneSummary {
+    std::string name;
+    unsigned int depth;
+    unsigned long callCount;
+    unsigned int threads; // number of threads which recorded the zone
+    double totalTime;     // µs, summed over all threads
+    double maxThreadTime; // µs, of the busiest thread
+  };
+
+  class Zone {
+  private:
+    const char *name;
+    int64_t argument;
+    uint64_t start;
+    bool active;
+    int counterSlot;
+
+  public:
+    /**
+     * @brief      Opens a zone which is recorded if the profiler is enabled at the given level.
+     * @param[in]  name      The name of the zone, must be a string literal.
+     * @param[in]  level     The lowest profiler level recording the zone.
+     * @param[in]  argument  Shown with the zone in the trace if not negative, e.g. a street id.
+     */
+    explicit Zone(const char *_name, Level level = PHASES, int64_t _argument = -1)
+        : name(_name), argument(_argument), start(0), active(level <= Profiler::level), counterSlot(-1) {
+      if (active) {
+        if (countingThread && level == PHASES) counterSlot = beginCounting(name);
+        ++depth;
+        start = now();
+      }
+    }
+    Zone(const Zone &other) = delete;
+    Zone &operator=(const Zone &other) = delete;
+    ~Zone() {
+      if (active) {
+        const uint64_t end = now();
+        --depth;
+        if (counterSlot >= 0) endCounting(counterSlot);
+        getThreadLog().events.push_back(Event{name, argument, start, end, depth});
+      }
+    }
+  };
+
+private:
+  struct Event {
+    const char *name;
+    int64_t argument;
+    uint64_t start;
+    uint64_t end;
+    unsigned int depth;
+  };
+
+  struct ThreadLog {
+    unsigned int thread;
+    std::vector<Event> events;
+  };
+
+  /**
+   * Performance counter values of the zones with the same name in the current window.
+   */
+  struct CounterSlot {
+    const char *name;
+    unsigned int depth;
+    PerfCounters::Values start;
+    PerfCounters::Values total;
+  };
+
+  static inline Level level = OFF;
+  static inline thread_local unsigned int depth      = 0;
+  static inline thread_local ThreadLog *threadLog    = nullptr;
+  static inline std::mutex registryMutex;
+  static inline std::vector<std::unique_ptr<ThreadLog>> threadLogs;
+
+  // reference points for converting timestamps to time, taken when enabling the profiler
+  static inline uint64_t enabledTimestamp = 0;
+  static inline std::chrono::steady_clock::time_point enabledTime;
+
+  static inline thread_local bool countingThread = false;
+  static inline std::vector<CounterSlot> counterSlots;
+  static inline unsigned int counterWindow      = 0; // steps
+  static inline unsigned int countedSteps       = 0;
+  static inline unsigned int windowSteps        = 0;
+  static inline std::ostream *counterReport     = nullptr;
+
+  /**
+   * Returns the log of the calling thread, registers it on first use.
+   */
+  static ThreadLog &getThreadLog() {
+    if (threadLog == nullptr) registerThread();
+    return *threadLog;
+  }
+  static void registerThread();
+
+  /**
+   * Returns the number of timestamp ticks per microsecond, measured since the profiler has been enabled.
+   */
+  static double getTicksPerMicrosecond();
+
+  static int beginCounting(const char *name);
+  static void endCounting(int slot);
+  static void printCounterWindow();
+
+public:
+  static uint64_t now() {
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+#endif
+  }
+
+  /**
+   * @brief      Enables recording zones up to the given level. Must be called before any zone is opened.
+   */
+  static void enable(Level level);
+  static Level getLevel() { return level; }
+
+  /**
+   * @brief      Reads the performance counters in the phase zones of the calling thread. Must be called after enabling
+   * the profiler and before any other thread is started.
+   * @param[in]  window  The number of steps whose counts are printed together.
+   * @param      report  The stream the counts are printed to.
+   * @param[out] error   The reason if the counters are not available.
+   * @return     True if at least one counter is available.
+   */
+  static bool enableCounters(unsigned int window, std::ostream &report, std::string &error);
+
+  /**
+   * @brief      Writes all recorded zones in the Chrome trace event format. Must not be called while zones are
+   * recorded.
+   */
+  static void writeChromeTrace(std::ostream &out);
+
+  /**
+   * @brief      Prints the number of calls and the total time of each zone, and how the time is distributed across the
+   * threads which recorded the zone. Must not be called while zones are recorded.
+   */
+  static void printSummary(std::ostream &out);
+
+  /**
+   * @brief      Summarizes the zones in the order they were first opened. Must not be called while zones are recorded.
+   */
+  static std::vector<ZoneSummary> summarize();
+
+  /**
+   * @brief      Discards all recorded zones, e.g. between two measurements. Must not be called while zones are
+   * recorded.
+   */
+  static void clear();
+};
+
+#endif
@@ -0,0 +1,119 @@
+#ifndef ROUTING_TABLE_H
+#define ROUTING_TABLE_H
+
+#include <stdexcept>
+#include <vector>
+
+#include "DomainModel.h"
+#include "LowLevelCar.h"
+
+/**
+ * The RoutingTable holds the street network and the vehicle routes of a domain model in flat arrays, so cars can be
+ * relocated to their next street without accessing the domain model.
+ *
+ * For each street and turn direction the table contains the street a car takes at the end of the street, i.e. after
+ * falling back to the next connected direction clockwise if the desired one is not connected, and the highest lane
+ * number of that street. The routes of all vehicles are concatenated, the position of a car within its route is kept
+ * in the low level car.
+ */
+class RoutingTable {
+public:
+  struct Destination {
+    unsigned int street;
+    unsigned int maxLane;
+  };
+
+private:
+  static constexpr unsigned int noStreet = static_cast<unsigned int>(-1);
+
+  std::vector<Destination> destinations; // indexed by 4 * street id + turn direction
+  std::vector<TurnDirection> routes;
+  std::vector<unsigned int> routeOffsets; // start of each vehicle's route in 'routes', one additional end entry
+
+public:
+  /**
+   * @brief      Calculates the resulting direction of a turn.
+   * @param[in]  origin  The direction where the car is coming from.
+   * @param[in]  turn    The direction of the turn.
+   * @return     The direction where the car is going.
+   */
+  static CardinalDirection takeTurn(CardinalDirection origin, TurnDirection turn) {
+    return (CardinalDirection)((origin + turn) % 4);
+  }
+
+  /**
+   * @brief      Determines the cardinal direction from where a street is coming to a junction.
+   * @param      junction        The junction, point of view for the direction.
+   * @param      incomingStreet  The street connected to the junction.
+   * @return     The origin cardinal direction related to the junction.
+   */
+  static CardinalDirection calculateOriginDirection(const Junction &junction, const Street &incomingStreet) {
+    for (const auto &connectedStreet : junction.getIncomingStreets()) {
+      if (connectedStreet.isConnected() && connectedStreet.getStreet()->getId() == incomingStreet.getId()) {
+        return connectedStreet.getDirection();
+      }
+    }
+    throw std::invalid_argument("Street is not connected to junction!");
+  }
+
+  RoutingTable() = default;
+
+  /**
+   * @brief      Builds the table for the streets and vehicles of the domain model. Streets which are not connected to
+   * their target junction or whose target junction has no outgoing streets get no destinations, relocating a car
+   * from them fails.
+   */
+  explicit RoutingTable(const DomainModel &domainModel) {
+    const auto &streets = domainModel.getStreets();
+    destinations.assign(4 * streets.size(), Destination{noStreet, 0});
+    for (const auto &street : streets) {
+      const Junction &junction = street.getTargetJunction();
+      int origin               = -1;
+      for (const auto &connectedStreet : junction.getIncomingStreets()) {
+        if (connectedStreet.isConnected() && connectedStreet.getStreet()->getId() == street.getId()) {
+          origin = connectedStreet.getDirection();
+        }
+      }
+      if (origin < 0) continue;
+
+      for (unsigned turn = UTURN; turn <= RIGHT; ++turn) {
+        CardinalDirection direction = takeTurn(CardinalDirection(origin), static_cast<TurnDirection>(turn));
+        for (unsigned attempt = 0; attempt < 3 && !junction.getOutgoingStreet(direction).isConnected(); ++attempt) {
+          direction = CardinalDirection((direction + 1) % 4);
+        }
+        const Street *destination = junction.getOutgoingStreet(direction).getStreet();
+        if (destination == nullptr) break;
+        destinations[4 * street.getId() + turn] = Destination{
+            static_cast<unsigned int>(destination->getId()), destination->getLanes() - 1};
+      }
+    }
+
+    const auto &vehicles = domainModel.getVehicles();
+    routeOffsets.reserve(vehicles.size() + 1);
+    for (const auto &vehicle : vehicles) {
+      routeOffsets.push_back(routes.size());
+      routes.insert(routes.end(), vehicle.getRoute().begin(), vehicle.getRoute().end());
+    }
+    routeOffsets.push_back(routes.size());
+  }
+
+  /**
+   * @brief      Determines the street a car takes at the end of its current street and advances the car's position
+   * in its route.
+   * @param      car     The car leaving the street.
+   * @param[in]  street  The id of the street the car is leaving.
+   * @return     The destination street and its highest lane number.
+   */
+  const Destination &takeNextTurn(LowLevelCar &car, unsigned int street) const {
+    const unsigned int routeIndex = routeOffsets[car.getId()] + car.getRouteIndex();
+    if (routeIndex >= routeOffsets[car.getId() + 1]) throw std::out_of_range("Vehicle has no route.");
+    const TurnDirection turn = routes[routeIndex];
+    car.setRouteIndex(routeIndex + 1 == routeOffsets[car.getId() + 1] ? 0 : car.getRouteIndex() + 1);
+
+    const Destination &destination = destinations[4 * street + turn];
+    if (destination.street == noStreet) throw std::invalid_argument("Street is not connected to junction!");
+    return destination;
+  }
+};
+
+#endif
@@ -1,11 +1,14 @@
 #ifndef SIMULATION_DATA_H
 #define SIMULATION_DATA_H
 
+#include <memory>
+#include <utility>
 #include <vector>
 
 #include "DomainModel.h"
 #include "LowLevelCar.h"
 #include "LowLevelStreet.h"
+#include "RoutingTable.h"
 
 /**
  * The SimulationData class holds all persistent data required during simulation.
@@ -22,6 +25,7 @@ public:
 private:
   DomainModel &domainModel;
   std::vector<Street> streets;
+  std::shared_ptr<const RoutingTable> routingTable; // shared by all simulations restored from the same snapshot
 
 public:
   SimulationData(DomainModel &_domainModel) : domainModel(_domainModel) {}
@@ -30,6 +34,9 @@ public:
   const Street &getStreet(unsigned int id) const { return streets.at(id); }
   std::vector<Street> &getStreets() { return streets; }
   const std::vector<Street> &getStreets() const { return streets; }
+  const RoutingTable &getRoutingTable() const { return *routingTable; }
+  const std::shared_ptr<const RoutingTable> &getSharedRoutingTable() const { return routingTable; }
+  void setRoutingTable(std::shared_ptr<const RoutingTable> _routingTable) { routingTable = std::move(_routingTable); }
   DomainModel &getDomainModel() { return domainModel; }
   const DomainModel &getDomainModel() const { return domainModel; }
 };
@@ -1,14 +1,18 @@
 #ifndef SIMULATOR_H
 #define SIMULATOR_H
 
+#include <istream>
+#include <ostream>
 #include <vector>
 
+#include "CheckpointFile.h"
 #include "DomainModel.h"
 #include "LowLevelCar.h"
 #include "LowLevelStreet.h"
 #include "ModelSyncer.h"
+#include "Profiler.h"
 #include "SimulationData.h"
-#include "Timer.h"
+#include "TrajectoryWriter.h"
 
 /**
  * C++20 ComputionRoutine concept, must be fulfilled in order for a class to be valid as a SignalingRoutine, IDMRoutine
@@ -41,10 +45,14 @@ template <template <typename Vehicle> typename RfbStructure,
     template <template <typename Vehicle> typename _RfbStructure> typename OptimizationRoutine,
     template <template <typename Vehicle> typename _RfbStructure> typename ConsistencyRoutine>
 class Simulator {
+public:
+  using Snapshot = typename ModelSyncer<RfbStructure>::Snapshot;
+
 private:
   SimulationData<RfbStructure> data;
 
   bool lowLevelInitialised;
+  const Snapshot *initialState = nullptr;
 
   SignalingRoutine<RfbStructure> signalingRoutine;
   IDMRoutine<RfbStructure> idmRoutine;
@@ -53,7 +61,11 @@ private:
 
 private:
   void initialiseLowLevel() {
-    ModelSyncer<RfbStructure>(data).buildFreshLowLevel();
+    if (initialState) {
+      ModelSyncer<RfbStructure>(data).restoreLowLevel(*initialState);
+    } else {
+      ModelSyncer<RfbStructure>(data).buildFreshLowLevel();
+    }
 
     lowLevelInitialised = true;
   }
@@ -61,28 +73,23 @@ private:
   void writeChangesToDomainModel() { ModelSyncer<RfbStructure>(data).writeVehiclePositionToDomainModel(); }
 
   void computeStep() {
-#ifdef TIMER
-    signalingRoutineTimer.start();
-    signalingRoutine.perform();
-    signalingRoutineTimer.stop();
-
-    idmRoutineTimer.start();
-    idmRoutine.perform();
-    idmRoutineTimer.stop();
-
-    optimizationRoutineTimer.start();
-    optimizationRoutine.perform();
-    optimizationRoutineTimer.stop();
-
-    consistencyRoutineTimer.start();
-    consistencyRoutine.perform();
-    consistencyRoutineTimer.stop();
-#else
-    signalingRoutine.perform();
-    idmRoutine.perform();
-    optimizationRoutine.perform();
-    consistencyRoutine.perform();
-#endif
+    Profiler::Zone stepZone("step");
+    {
+      Profiler::Zone zone("signalingRoutine");
+      signalingRoutine.perform();
+    }
+    {
+      Profiler::Zone zone("idmRoutine");
+      idmRoutine.perform();
+    }
+    {
+      Profiler::Zone zone("optimizationRoutine");
+      optimizationRoutine.perform();
+    }
+    {
+      Profiler::Zone zone("consistencyRoutine");
+      consistencyRoutine.perform();
+    }
   }
 
 public:
@@ -90,6 +97,24 @@ public:
       : data(_domainModel), lowLevelInitialised(false), signalingRoutine(data), idmRoutine(data),
         optimizationRoutine(data), consistencyRoutine(data) {}
 
+  /**
+   * Creates a simulator which initialises its low level model from a snapshot instead of building it from the domain
+   * model. The snapshot must have been taken from a simulator operating on the same domain model in the same state
+   * (apart from the signal plan) and must outlive the simulator's initialisation.
+   */
+  Simulator(DomainModel &_domainModel, const Snapshot &_initialState) : Simulator(_domainModel) {
+    initialState = &_initialState;
+  }
+
+  /**
+   * Takes a snapshot of the current low level model, initialises it first if necessary.
+   */
+  Snapshot takeSnapshot() {
+    if (!lowLevelInitialised) initialiseLowLevel();
+
+    return ModelSyncer<RfbStructure>(data).takeSnapshot();
+  }
+
   void performStep() {
     if (!lowLevelInitialised) initialiseLowLevel();
 
@@ -106,7 +131,61 @@ public:
     writeChangesToDomainModel();
   }
 
+  /**
+   * Performs at most n steps, stops early once the stop condition is fulfilled.
+   * The stop condition is called after each step with the number of steps performed so far and returns true if the
+   * simulation should be stopped.
+   * @return     The number of steps actually performed.
+   */
+  template <typename StopCondition>
+  unsigned int performStepsUntil(unsigned int n, StopCondition stopCondition) {
+    if (!lowLevelInitialised) initialiseLowLevel();
+
+    unsigned int performedSteps = 0;
+    while (performedSteps < n) {
+      computeStep();
+      if (stopCondition(++performedSteps)) break;
+    }
+
+    writeChangesToDomainModel();
+    return performedSteps;
+  }
+
+  /**
+   * Records the current vehicle positions as the frame of the given step, initialises the low level model first if
+   * necessary.
+   */
+  void recordTrajectoryFrame(TrajectoryWriter &trajectoryWriter, unsigned int step) {
+    if (!lowLevelInitialised) initialiseLowLevel();
+
+    TrajectoryWriter::Frame &frame = trajectoryWriter.beginFrame(step);
+    ModelSyncer<RfbStructure>(data).captureVehiclePositions(frame.positions);
+    trajectoryWriter.submitFrame();
+  }
+
+  /**
+   * Writes the complete state of the simulation after the given number of steps to the checkpoint file, initialises
+   * the low level model first if necessary.
+   */
+  void writeCheckpoint(CheckpointFile &checkpointFile, unsigned int step) {
+    if (!lowLevelInitialised) initialiseLowLevel();
+
+    checkpointFile.write(
+        [this, step](std::ostream &out) { ModelSyncer<RfbStructure>(data).writeCheckpoint(out, step); });
+  }
+
+  /**
+   * Initialises the low level model from a checkpoint instead of the domain model, see ModelSyncer::restoreCheckpoint.
+   * @return     The number of steps performed before the checkpoint.
+   */
+  unsigned int restoreCheckpoint(std::istream &in) {
+    const unsigned int step = ModelSyncer<RfbStructure>(data).restoreCheckpoint(in);
+    lowLevelInitialised     = true;
+    return step;
+  }
+
   const SimulationData<RfbStructure> &getData() const { return data; }
+  SimulationData<RfbStructure> &getData() { return data; }
 
   const SignalingRoutine<RfbStructure> &getSignalingRoutine() const { return signalingRoutine; }
   const IDMRoutine<RfbStructure> &getIDMRoutine() const { return idmRoutine; }
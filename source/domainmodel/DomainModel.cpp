@@ -1,46 +1,89 @@
 #include "DomainModel.h"
 
-#include <memory>
+#include <utility>
+
+DomainModel::DomainModel(const DomainModel &other) : greenWave(other.greenWave) {
+  reserve(other.junctions.size(), other.streets.size(), other.vehicles.size());
+
+  // junctions are copied first, their connected streets are redirected once the new streets exist
+  for (auto const &junction : other.junctions) { junctions.emplace_back(junction); }
+
+  for (auto const &street : other.streets) {
+    Junction &from = junctions[street.getSourceJunction().getId()];
+    Junction &to   = junctions[street.getTargetJunction().getId()];
+    streets.emplace_back(street.getId(), street.getLanes(), street.getSpeedLimit(), street.getLength(), from, to);
+  }
+
+  for (auto &junction : junctions) {
+    for (const auto &incoming : junction.getIncomingStreets()) {
+      if (incoming.isConnected()) {
+        junction.addIncomingStreet(streets[incoming.getStreet()->getId()], incoming.getDirection());
+      }
+    }
+    for (const auto &outgoing : junction.getOutgoingStreets()) {
+      if (outgoing.isConnected()) {
+        junction.addOutgoingStreet(streets[outgoing.getStreet()->getId()], outgoing.getDirection());
+      }
+    }
+  }
+
+  for (auto const &vehicle : other.vehicles) {
+    const Vehicle::Position &start = vehicle.startingPosition;
+    const Vehicle::Position &now   = vehicle.position;
+    Vehicle &copy = vehicles.emplace_back(vehicle.getId(), vehicle.getExternalId(), vehicle.getTargetVelocity(),
+        vehicle.getMaxAcceleration(), vehicle.getTargetDeceleration(), vehicle.getMinDistance(),
+        vehicle.getTargetHeadway(), vehicle.getPoliteness(), vehicle.getRoute(),
+        Vehicle::Position(streets[start.getStreet()->getId()], start.getLane(), start.getDistance()));
+    copy.position       = Vehicle::Position(streets[now.getStreet()->getId()], now.getLane(), now.getDistance());
+    copy.directionIndex = vehicle.directionIndex;
+  }
+}
 
 void DomainModel::resetModel() {
-  for (auto const &vehicle : vehicles) { vehicle->resetPosition(); }
-  for (auto const &junction : junctions) { junction->initJunction(); }
+  for (auto &vehicle : vehicles) { vehicle.resetPosition(); }
+  for (auto &junction : junctions) { junction.initJunction(); }
+}
+
+void DomainModel::reserve(std::size_t junctionCount, std::size_t streetCount, std::size_t vehicleCount) {
+  junctions.reserve(junctionCount);
+  streets.reserve(streetCount);
+  vehicles.reserve(vehicleCount);
 }
 
 Vehicle &DomainModel::addVehicle(const Vehicle &vehicle) {
-  vehicles.emplace_back(new Vehicle(vehicle));
-  vehicles.back()->id = vehicles.size() - 1;
-  return *vehicles.back();
+  Vehicle &added = vehicles.emplace_back(vehicle);
+  added.id       = vehicles.size() - 1;
+  return added;
 }
 
 Junction &DomainModel::addJunction(const Junction &junction) {
-  junctions.emplace_back(new Junction(junction));
-  junctions.back()->id = junctions.size() - 1;
-  return *junctions.back();
+  Junction &added = junctions.emplace_back(junction);
+  added.id        = junctions.size() - 1;
+  return added;
 }
 
 Street &DomainModel::addStreet(const Street &street) {
-  streets.emplace_back(new Street(street));
-  streets.back()->id = streets.size() - 1;
-  return *streets.back();
+  Street &added = streets.emplace_back(street);
+  added.id      = streets.size() - 1;
+  return added;
 }
 
 Vehicle &DomainModel::addVehicle(Vehicle &&vehicle) {
-  vehicles.emplace_back(new Vehicle(vehicle));
-  vehicles.back()->id = vehicles.size() - 1;
-  return *vehicles.back();
+  Vehicle &added = vehicles.emplace_back(std::move(vehicle));
+  added.id       = vehicles.size() - 1;
+  return added;
 }
 
 Street &DomainModel::addStreet(Street &&street) {
-  streets.emplace_back(new Street(street));
-  streets.back()->id = streets.size() - 1;
-  return *streets.back();
+  Street &added = streets.emplace_back(std::move(street));
+  added.id      = streets.size() - 1;
+  return added;
 }
 
 Junction &DomainModel::addJunction(Junction &&junction) {
-  junctions.emplace_back(new Junction(junction));
-  junctions.back()->id = junctions.size() - 1;
-  return *junctions.back();
+  Junction &added = junctions.emplace_back(std::move(junction));
+  added.id        = junctions.size() - 1;
+  return added;
 }
 
 void DomainModel::setGreenWave(bool _greenWave) { greenWave = _greenWave; }
@@ -50,12 +93,15 @@ bool DomainModel::isGreenWave() { return greenWave; }
 /*
  * Access methods:
  */
-Vehicle &DomainModel::getVehicle(id_type id) { return *vehicles.at(id); }
-Street &DomainModel::getStreet(id_type id) { return *streets.at(id); }
-Junction &DomainModel::getJunction(id_type id) { return *junctions.at(id); }
-const Vehicle &DomainModel::getVehicle(id_type id) const { return *vehicles.at(id); }
-const Street &DomainModel::getStreet(id_type id) const { return *streets.at(id); }
-const Junction &DomainModel::getJunction(id_type id) const { return *junctions.at(id); }
-const std::vector<std::unique_ptr<Vehicle>> &DomainModel::getVehicles() const { return vehicles; }
-const std::vector<std::unique_ptr<Street>> &DomainModel::getStreets() const { return streets; }
-const std::vector<std::unique_ptr<Junction>> &DomainModel::getJunctions() const { return junctions; }
+Vehicle &DomainModel::getVehicle(id_type id) { return vehicles.at(id); }
+Street &DomainModel::getStreet(id_type id) { return streets.at(id); }
+Junction &DomainModel::getJunction(id_type id) { return junctions.at(id); }
+const Vehicle &DomainModel::getVehicle(id_type id) const { return vehicles.at(id); }
+const Street &DomainModel::getStreet(id_type id) const { return streets.at(id); }
+const Junction &DomainModel::getJunction(id_type id) const { return junctions.at(id); }
+ElementStorage<Vehicle> &DomainModel::getVehicles() { return vehicles; }
+ElementStorage<Street> &DomainModel::getStreets() { return streets; }
+ElementStorage<Junction> &DomainModel::getJunctions() { return junctions; }
+const ElementStorage<Vehicle> &DomainModel::getVehicles() const { return vehicles; }
+const ElementStorage<Street> &DomainModel::getStreets() const { return streets; }
+const ElementStorage<Junction> &DomainModel::getJunctions() const { return junctions; }
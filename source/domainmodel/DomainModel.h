@@ -1,28 +1,43 @@
 #ifndef DOMAINMODEL_H
 #define DOMAINMODEL_H
 
-#include <memory>
-#include <vector>
+#include <cstddef>
 
 #include "DomainModelCommon.h"
+#include "ElementStorage.h"
 #include "Junction.h"
 #include "Street.h"
 #include "Vehicle.h"
 
 class DomainModel {
 private:
-  std::vector<std::unique_ptr<Vehicle>> vehicles;
-  std::vector<std::unique_ptr<Street>> streets;
-  std::vector<std::unique_ptr<Junction>> junctions;
+  ElementStorage<Vehicle> vehicles;
+  ElementStorage<Street> streets;
+  ElementStorage<Junction> junctions;
 
   bool greenWave = false;
 
 public:
   DomainModel() = default;
+  /**
+   * @brief      Creates a deep copy of another domain model.
+   * All vehicles, streets and junctions are copied including their current state (vehicle positions and route indices,
+   * signals and traffic light timers). References between the copied elements are redirected to the new elements.
+   * @param[in]  other  The domain model to copy.
+   */
+  DomainModel(const DomainModel &other);
+  DomainModel(DomainModel &&other) = default;
+  DomainModel &operator=(const DomainModel &other) = delete;
+  DomainModel &operator=(DomainModel &&other) = default;
 
   void resetModel();
 
   // methods for building the domain model:
+  /**
+   * @brief      Reserves space for the given number of elements, which are then stored contiguously. Must be called
+   * before adding the first element to take effect.
+   */
+  void reserve(std::size_t junctionCount, std::size_t streetCount, std::size_t vehicleCount);
   Vehicle &addVehicle(const Vehicle &vehicle);
   Street &addStreet(const Street &street);
   Junction &addJunction(const Junction &junction);
@@ -42,10 +57,13 @@ public:
   const Street &getStreet(id_type id) const;
   const Junction &getJunction(id_type id) const;
 
-  // access methods for the full sets:
-  const std::vector<std::unique_ptr<Vehicle>> &getVehicles() const;
-  const std::vector<std::unique_ptr<Street>> &getStreets() const;
-  const std::vector<std::unique_ptr<Junction>> &getJunctions() const;
+  // access methods for the full sets, indexed by id without bounds checks:
+  ElementStorage<Vehicle> &getVehicles();
+  ElementStorage<Street> &getStreets();
+  ElementStorage<Junction> &getJunctions();
+  const ElementStorage<Vehicle> &getVehicles() const;
+  const ElementStorage<Street> &getStreets() const;
+  const ElementStorage<Junction> &getJunctions() const;
 };
 
 #endif
@@ -0,0 +1,134 @@
+#ifndef ELEMENT_STORAGE_H
+#define ELEMENT_STORAGE_H
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief      Storage for the elements of the domain model, indexed by their id.
+ *
+ * The elements refer to each other by reference, i.e. they must never move once added. Instead of allocating each
+ * element separately, the elements are stored in blocks which never grow beyond their initial capacity. If the number
+ * of elements is reserved before adding the first one, all elements are stored contiguously in a single block.
+ * Otherwise further blocks of a fixed size are appended as needed.
+ *
+ * @tparam     T     The type of the elements.
+ */
+template <typename T>
+class ElementStorage {
+private:
+  static constexpr std::size_t blockSize = 1024;
+
+  std::vector<std::vector<T>> blocks;
+  T *firstBlock                  = nullptr;
+  std::size_t firstBlockCapacity = 0;
+  std::size_t lastBlockCapacity  = 0; // the number of elements the last block is meant to hold
+  std::size_t count              = 0;
+
+  template <typename Storage, typename Element>
+  class Iterator {
+  private:
+    Storage *storage;
+    std::size_t index;
+
+  public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type        = T;
+    using difference_type   = std::ptrdiff_t;
+    using pointer           = Element *;
+    using reference         = Element &;
+
+    Iterator(Storage *_storage, std::size_t _index) : storage(_storage), index(_index) {}
+
+    reference operator*() const { return (*storage)[index]; }
+    pointer operator->() const { return &(*storage)[index]; }
+    Iterator &operator++() {
+      ++index;
+      return *this;
+    }
+    Iterator operator++(int) {
+      Iterator previous = *this;
+      ++index;
+      return previous;
+    }
+    bool operator==(const Iterator &other) const { return index == other.index; }
+    bool operator!=(const Iterator &other) const { return index != other.index; }
+  };
+
+  // reserve() may allocate more than requested, so the number of elements per block is tracked separately
+  void addBlock(std::size_t capacity) {
+    blocks.emplace_back();
+    blocks.back().reserve(capacity);
+    lastBlockCapacity = capacity;
+    if (blocks.size() == 1) {
+      firstBlock         = blocks.back().data();
+      firstBlockCapacity = capacity;
+    }
+  }
+
+public:
+  using iterator       = Iterator<ElementStorage, T>;
+  using const_iterator = Iterator<const ElementStorage, const T>;
+
+  ElementStorage() = default;
+  ElementStorage(const ElementStorage &other) = delete;
+  ElementStorage(ElementStorage &&other) { *this = std::move(other); }
+  ElementStorage &operator=(const ElementStorage &other) = delete;
+  ElementStorage &operator=(ElementStorage &&other) {
+    // the blocks keep their memory when moved, i.e. the pointer to the first block stays valid
+    blocks             = std::move(other.blocks);
+    firstBlock         = std::exchange(other.firstBlock, nullptr);
+    firstBlockCapacity = std::exchange(other.firstBlockCapacity, 0);
+    lastBlockCapacity  = std::exchange(other.lastBlockCapacity, 0);
+    count              = std::exchange(other.count, 0);
+    other.blocks.clear();
+    return *this;
+  }
+
+  /**
+   * @brief      Reserves space for 'capacity' elements in a single block. Has no effect once elements have been added.
+   */
+  void reserve(std::size_t capacity) {
+    if (count > 0) return;
+    blocks.clear();
+    addBlock(std::max<std::size_t>(capacity, 1));
+  }
+
+  template <typename... Args>
+  T &emplace_back(Args &&... args) {
+    if (blocks.empty() || blocks.back().size() == lastBlockCapacity) addBlock(blockSize);
+    blocks.back().emplace_back(std::forward<Args>(args)...);
+    ++count;
+    return blocks.back().back();
+  }
+
+  std::size_t size() const { return count; }
+  bool empty() const { return count == 0; }
+
+  T &operator[](std::size_t index) {
+    if (index < firstBlockCapacity) return firstBlock[index];
+    index -= firstBlockCapacity;
+    return blocks[1 + index / blockSize][index % blockSize];
+  }
+  const T &operator[](std::size_t index) const { return const_cast<ElementStorage &>(*this)[index]; }
+
+  T &at(std::size_t index) {
+    if (index >= count) throw std::out_of_range("ElementStorage::at: index out of range");
+    return (*this)[index];
+  }
+  const T &at(std::size_t index) const { return const_cast<ElementStorage &>(*this).at(index); }
+
+  T &back() { return blocks.back().back(); }
+  const T &back() const { return blocks.back().back(); }
+
+  iterator begin() { return iterator(this, 0); }
+  iterator end() { return iterator(this, count); }
+  const_iterator begin() const { return const_iterator(this, 0); }
+  const_iterator end() const { return const_iterator(this, count); }
+};
+
+#endif
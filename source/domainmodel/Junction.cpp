@@ -77,6 +77,15 @@ void Junction::setSignals(std::vector<Signal> &&newSignals) {
   initJunction(); // reset timer and current signal index
 }
 
+void Junction::restoreSignalState(int _signalIndex, int _currentTimer) {
+  const bool valid = signals.empty() ? (_signalIndex == -1 && _currentTimer == -1)
+                                     : (_signalIndex >= 0 && static_cast<std::size_t>(_signalIndex) < signals.size() &&
+                                           _currentTimer >= 0);
+  if (!valid) { throw JunctionException(*this, "Invalid signal state!"); }
+  signalIndex  = _signalIndex;
+  currentTimer = _currentTimer;
+}
+
 // Access methods:
 id_type Junction::getId() const { return id; }
 int Junction::getExternalId() const { return externalId; }
@@ -92,6 +101,8 @@ Junction::Signal Junction::getPreviousSignal() const {
   return signals.at(indexOfPrevious);
 }
 const std::vector<Junction::Signal> &Junction::getSignals() const { return signals; }
+int Junction::getSignalIndex() const { return signalIndex; }
+int Junction::getCurrentTimer() const { return currentTimer; }
 const Junction::ConnectedStreet &Junction::getIncomingStreet(CardinalDirection direction) const {
   return incomingStreets[direction];
 }
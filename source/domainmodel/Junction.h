@@ -99,6 +99,13 @@ public:
    */
   void setSignals(std::vector<Signal> &&newSignals);
 
+  /**
+   * @brief      Restores the current signal and its timer, e.g. from a checkpoint.
+   * @param[in]  signalIndex   The index of the current signal.
+   * @param[in]  currentTimer  The remaining steps of the current signal.
+   */
+  void restoreSignalState(int signalIndex, int currentTimer);
+
   // access methods:
   id_type getId() const;
   int getExternalId() const;
@@ -107,6 +114,8 @@ public:
   Signal getCurrentSignal() const;  // is also the signal that is green
   Signal getPreviousSignal() const; // is also the last signal that has been green before the current
   const std::vector<Signal> &getSignals() const;
+  int getSignalIndex() const;
+  int getCurrentTimer() const;
   const ConnectedStreet &getIncomingStreet(CardinalDirection direction) const;
   const ConnectedStreet &getOutgoingStreet(CardinalDirection direction) const;
   const std::array<ConnectedStreet, 4> &getIncomingStreets() const;
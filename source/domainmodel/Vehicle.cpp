@@ -34,7 +34,11 @@ void Vehicle::setPosition(const Position &_position) {
 void Vehicle::setPosition(Street &street, unsigned int lane, double distance) {
   Vehicle::Position position(street, lane, distance);
   setPosition(position);
-  checkPosition();
+}
+
+void Vehicle::updatePosition(Street &street, unsigned int lane, double distance, int _directionIndex) {
+  position       = Vehicle::Position(street, lane, distance);
+  directionIndex = _directionIndex;
 }
 
 void Vehicle::resetPosition() {
@@ -44,6 +48,11 @@ void Vehicle::resetPosition() {
 }
 
 void Vehicle::checkPosition() { // TODO remove for final version
+  if (position.getLane() < position.getStreet()->getLanes() &&
+      position.getDistance() <= position.getStreet()->getLength())
+    return;
+
+  // the message is only built for invalid positions, this runs for every position update
   std::stringstream stream;
   stream << "Invalid vehicle position for vehicle " << getId() << ", ";
   if (position.getLane() >= position.getStreet()->getLanes()) {
@@ -62,6 +71,15 @@ TurnDirection Vehicle::getNextDirection() {
   return next;
 }
 
+void Vehicle::restoreDirectionIndex(int _directionIndex) {
+  if (_directionIndex < 0 || static_cast<std::size_t>(_directionIndex) >= route.size()) {
+    std::stringstream stream;
+    stream << "Invalid route index " << _directionIndex << " for vehicle " << getId() << "!";
+    throw std::invalid_argument(stream.str());
+  }
+  directionIndex = _directionIndex;
+}
+
 id_type Vehicle::getId() const { return id; }
 int Vehicle::getExternalId() const { return externalId; }
 double Vehicle::getTargetVelocity() const { return targetVelocity; }
@@ -72,3 +90,4 @@ double Vehicle::getTargetHeadway() const { return targetHeadway; }
 double Vehicle::getPoliteness() const { return politeness; }
 const Vehicle::Position &Vehicle::getPosition() const { return position; }
 const std::vector<TurnDirection> &Vehicle::getRoute() const { return route; }
+int Vehicle::getDirectionIndex() const { return directionIndex; }
@@ -61,6 +61,16 @@ public:
    */
   void setPosition(Street &street, unsigned int lane, double distance);
 
+  /**
+   * @brief      Updates the position and the route index of the car without validating them. Meant for the state taken
+   * from the simulation, which never moves a car off its street.
+   * @param      street          is the new street.
+   * @param[in]  lane            is the new lane number.
+   * @param[in]  distance        is the new distance on the street in meters.
+   * @param[in]  directionIndex  is the index of the next turn in the route.
+   */
+  void updatePosition(Street &street, unsigned int lane, double distance, int directionIndex);
+
   /**
    * @brief      Sets the car back to its original position.
    */
@@ -75,6 +85,12 @@ public:
    */
   TurnDirection getNextDirection();
 
+  /**
+   * @brief      Restores the position within the route, e.g. from a checkpoint.
+   * @param[in]  directionIndex  The index of the next direction of the route.
+   */
+  void restoreDirectionIndex(int directionIndex);
+
   // access methods:
   id_type getId() const;
   int getExternalId() const;
@@ -86,6 +102,7 @@ public:
   double getPoliteness() const;
   const Position &getPosition() const;
   const std::vector<TurnDirection> &getRoute() const;
+  int getDirectionIndex() const;
 };
 
 #endif
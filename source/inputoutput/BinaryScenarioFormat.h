@@ -0,0 +1,194 @@
+#ifndef BINARY_SCENARIO_FORMAT_H
+#define BINARY_SCENARIO_FORMAT_H
+
+#include <cstdint>
+#include <cstring>
+
+/**
+ * Layout of the binary scenario format shared by BinaryScenarioReader and BinaryScenarioWriter.
+ *
+ * A binary scenario is a serialized domain model: a header followed by the junction, signal, street, vehicle and turn
+ * tables, each one a flat array of fixed size little-endian records. Elements refer to each other by their index in the
+ * respective table, which is the id of the element in the domain model. All record sizes are multiples of 8 bytes, i.e.
+ * the tables stay aligned if the file is mapped into memory.
+ *
+ * The vehicle positions after a simulation can be written in the same manner: a result header followed by a table of
+ * vehicle position records. A trajectory contains such a table for each of a series of steps.
+ *
+ * A checkpoint contains the dynamic state of a running simulation, which is not part of the scenario: a checkpoint
+ * header followed by the junction, street, car and route index tables. The cars are grouped by street in the order of
+ * the streets.
+ */
+struct BinaryScenarioFormat {
+  /**
+   * Starts with a non-ASCII byte like PNG, so the format can be told apart from JSON by the first character.
+   */
+  static constexpr char magic[8]           = {'\x89', 'T', 'S', 'I', 'M', '\r', '\n', '\x1a'};
+  static constexpr char resultMagic[8]     = {'\x89', 'T', 'S', 'I', 'M', 'R', '\n', '\x1a'};
+  static constexpr char trajectoryMagic[8] = {'\x89', 'T', 'S', 'I', 'M', 'T', '\n', '\x1a'};
+  static constexpr char checkpointMagic[8] = {'\x89', 'T', 'S', 'I', 'M', 'C', '\n', '\x1a'};
+  static constexpr uint32_t version        = 1;
+  static constexpr uint32_t noElement      = UINT32_MAX;
+
+  struct Header {
+    char magic[8];
+    uint32_t version;
+    uint32_t mode; // JSONReader::Mode
+    uint32_t timeSteps;
+    uint32_t minTravelDistance;
+    uint32_t junctionCount;
+    uint32_t signalCount;
+    uint32_t streetCount;
+    uint32_t vehicleCount;
+    uint32_t turnCount;
+    uint32_t reserved;
+  };
+
+  struct JunctionRecord {
+    int32_t externalId;
+    int32_t x;
+    int32_t y;
+    uint32_t firstSignal;
+    uint32_t signalCount;
+    uint32_t incomingStreets[4]; // indexed by cardinal direction, noElement if not connected
+    uint32_t outgoingStreets[4];
+    uint32_t reserved;
+  };
+
+  struct SignalRecord {
+    uint32_t direction;
+    uint32_t duration; // s
+  };
+
+  struct StreetRecord {
+    uint32_t lanes;
+    uint32_t sourceJunction;
+    uint32_t targetJunction;
+    uint32_t reserved;
+    double speedLimit; // m/s
+    double length;     // m
+  };
+
+  struct VehicleRecord {
+    int32_t externalId;
+    uint32_t street;
+    uint32_t lane;
+    uint32_t firstTurn;
+    uint32_t turnCount;
+    uint32_t reserved;
+    double targetVelocity; // m/s
+    double maxAcceleration;
+    double targetDeceleration;
+    double minDistance;
+    double targetHeadway;
+    double politeness;
+    double distance;
+  };
+
+  using TurnRecord = uint8_t;
+
+  struct ResultHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t vehicleCount;
+  };
+
+  /**
+   * Position of a vehicle like in the JSON output: the street is given by the external ids of its junctions.
+   */
+  struct VehiclePositionRecord {
+    int32_t externalId;
+    int32_t fromJunction;
+    int32_t toJunction;
+    uint32_t lane;
+    double distance; // m
+  };
+
+  struct TrajectoryHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t vehicleCount;
+    uint32_t interval; // steps between two frames
+    uint32_t reserved;
+  };
+
+  /**
+   * Precedes the vehicle positions of each step in a trajectory.
+   */
+  struct FrameHeader {
+    uint32_t step;
+    uint32_t vehicleCount;
+  };
+
+  struct CheckpointHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t step; // number of steps performed before the checkpoint
+    uint32_t junctionCount;
+    uint32_t streetCount;
+    uint32_t vehicleCount;
+    uint32_t carCount;
+    uint32_t bucketListSectionLength;
+    uint32_t reserved;
+  };
+
+  struct JunctionStateRecord {
+    int32_t signalIndex;
+    int32_t currentTimer;
+  };
+
+  struct StreetStateRecord {
+    uint32_t signal; // Signal of the traffic light at the end of the street
+    uint32_t carCount;
+  };
+
+  /**
+   * The dynamic properties of a low level car, the static ones are taken from the vehicle in the domain model.
+   */
+  struct CarStateRecord {
+    uint32_t vehicle;
+    uint32_t lane;
+    double distance;
+    double velocity;
+    double travelDistance;
+  };
+
+  using RouteIndexRecord = int32_t;
+
+  /**
+   * The records are stored in host byte order, which matches the format only on little-endian hosts.
+   */
+  static bool isHostLittleEndian() {
+    const uint32_t probe = 1;
+    char firstByte;
+    std::memcpy(&firstByte, &probe, 1);
+    return firstByte == 1;
+  }
+
+  /**
+   * Size of the turn table, rounded up to keep the file size a multiple of 8 bytes.
+   */
+  static uint64_t paddedTurnTableSize(const uint32_t turnCount) { return (uint64_t(turnCount) + 7) / 8 * 8; }
+
+  static uint64_t fileSize(const Header &header) {
+    return sizeof(Header) + uint64_t(header.junctionCount) * sizeof(JunctionRecord) +
+           uint64_t(header.signalCount) * sizeof(SignalRecord) + uint64_t(header.streetCount) * sizeof(StreetRecord) +
+           uint64_t(header.vehicleCount) * sizeof(VehicleRecord) + paddedTurnTableSize(header.turnCount);
+  }
+};
+
+static_assert(sizeof(BinaryScenarioFormat::Header) == 48, "unexpected padding in binary scenario header");
+static_assert(sizeof(BinaryScenarioFormat::JunctionRecord) == 56, "unexpected padding in binary junction record");
+static_assert(sizeof(BinaryScenarioFormat::SignalRecord) == 8, "unexpected padding in binary signal record");
+static_assert(sizeof(BinaryScenarioFormat::StreetRecord) == 32, "unexpected padding in binary street record");
+static_assert(sizeof(BinaryScenarioFormat::VehicleRecord) == 80, "unexpected padding in binary vehicle record");
+static_assert(sizeof(BinaryScenarioFormat::ResultHeader) == 16, "unexpected padding in binary result header");
+static_assert(sizeof(BinaryScenarioFormat::VehiclePositionRecord) == 24, "unexpected padding in position record");
+static_assert(sizeof(BinaryScenarioFormat::TrajectoryHeader) == 24, "unexpected padding in trajectory header");
+static_assert(sizeof(BinaryScenarioFormat::FrameHeader) == 8, "unexpected padding in trajectory frame header");
+static_assert(sizeof(BinaryScenarioFormat::CheckpointHeader) == 40, "unexpected padding in checkpoint header");
+static_assert(sizeof(BinaryScenarioFormat::JunctionStateRecord) == 8, "unexpected padding in junction state record");
+static_assert(sizeof(BinaryScenarioFormat::StreetStateRecord) == 8, "unexpected padding in street state record");
+static_assert(sizeof(BinaryScenarioFormat::CarStateRecord) == 32, "unexpected padding in car state record");
+
+#endif
@@ -0,0 +1,210 @@
+#include "BinaryScenarioReader.h"
+
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <istream>
+#include <iterator>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "BinaryScenarioFormat.h"
+#include "DomainModel.h"
+#include "DomainModelCommon.h"
+#include "JSONReader.h"
+#include "Junction.h"
+#include "Street.h"
+#include "Vehicle.h"
+
+using Format = BinaryScenarioFormat;
+
+BinaryScenarioReader::Exception::Exception(const char *_what) : whatStr(_what) {}
+
+const char *BinaryScenarioReader::Exception::what() const throw() { return whatStr.c_str(); }
+
+bool BinaryScenarioReader::isMappable(int fd) {
+  struct stat fileStatus;
+  return fstat(fd, &fileStatus) == 0 && S_ISREG(fileStatus.st_mode);
+}
+
+bool BinaryScenarioReader::isBinaryScenario(int fd) {
+  char magic[sizeof(Format::magic)];
+  return pread(fd, magic, sizeof(magic), 0) == sizeof(magic) && std::memcmp(magic, Format::magic, sizeof(magic)) == 0;
+}
+
+bool BinaryScenarioReader::isBinaryScenario(std::istream &in) {
+  return in.peek() == std::char_traits<char>::to_int_type(Format::magic[0]);
+}
+
+BinaryScenarioReader::BinaryScenarioReader(int fd)
+    : data(nullptr), size(0), mapped(false), hasBeenRead(false), timeSteps(0), mode(JSONReader::SIMULATE),
+      minTravelDistance(0) {
+  struct stat fileStatus;
+  if (fstat(fd, &fileStatus) != 0 || !S_ISREG(fileStatus.st_mode))
+    throw BinaryScenarioReader::Exception("Binary scenario is not a regular file.");
+
+  size = fileStatus.st_size;
+  if (size == 0) return; // an empty mapping is invalid, reported by readInto
+
+  void *mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+  if (mapping == MAP_FAILED) throw BinaryScenarioReader::Exception("Mapping the binary scenario failed.");
+  madvise(mapping, size, MADV_SEQUENTIAL);
+
+  data   = static_cast<const char *>(mapping);
+  mapped = true;
+}
+
+BinaryScenarioReader::BinaryScenarioReader(std::istream &in)
+    : buffer(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>()), hasBeenRead(false), timeSteps(0),
+      mode(JSONReader::SIMULATE), minTravelDistance(0) {
+  data   = buffer.data();
+  size   = buffer.size();
+  mapped = false;
+}
+
+BinaryScenarioReader::~BinaryScenarioReader() {
+  if (mapped) munmap(const_cast<char *>(data), size);
+}
+
+template <typename Record>
+Record BinaryScenarioReader::readRecord(std::size_t offset) const {
+  // copy instead of casting the pointer, the buffer of a stream is not necessarily aligned
+  Record record;
+  std::memcpy(&record, data + offset, sizeof(Record));
+  return record;
+}
+
+void BinaryScenarioReader::readInto(DomainModel &domainModel) {
+  if (hasBeenRead)
+    throw BinaryScenarioReader::Exception("Attempting to read input although input has already been read.");
+  if (!Format::isHostLittleEndian())
+    throw BinaryScenarioReader::Exception("Binary scenarios are only supported on little-endian hosts.");
+
+  if (size < sizeof(Format::Header)) throw BinaryScenarioReader::Exception("Binary scenario is truncated.");
+  const auto header = readRecord<Format::Header>(0);
+  if (std::memcmp(header.magic, Format::magic, sizeof(Format::magic)) != 0)
+    throw BinaryScenarioReader::Exception("Input is not a binary scenario.");
+  if (header.version != Format::version)
+    throw BinaryScenarioReader::Exception("Unsupported version of the binary scenario format.");
+  if (size < Format::fileSize(header)) throw BinaryScenarioReader::Exception("Binary scenario is truncated.");
+  if (header.mode != JSONReader::SIMULATE && header.mode != JSONReader::OPTIMIZE)
+    throw BinaryScenarioReader::Exception("Invalid mode in binary scenario.");
+
+  const std::size_t junctionsOffset = sizeof(Format::Header);
+  const std::size_t signalsOffset   = junctionsOffset + header.junctionCount * sizeof(Format::JunctionRecord);
+  const std::size_t streetsOffset   = signalsOffset + header.signalCount * sizeof(Format::SignalRecord);
+  const std::size_t vehiclesOffset  = streetsOffset + header.streetCount * sizeof(Format::StreetRecord);
+  const std::size_t turnsOffset     = vehiclesOffset + header.vehicleCount * sizeof(Format::VehicleRecord);
+
+  domainModel.reserve(header.junctionCount, header.streetCount, header.vehicleCount);
+
+  std::vector<Junction *> junctions;
+  std::unordered_set<int> junctionIds;
+  junctions.reserve(header.junctionCount);
+  for (std::size_t i = 0; i < header.junctionCount; ++i) {
+    const auto junction = readRecord<Format::JunctionRecord>(junctionsOffset + i * sizeof(Format::JunctionRecord));
+    if (!junctionIds.insert(junction.externalId).second)
+      throw BinaryScenarioReader::Exception("Duplicate Junction ID encountered.");
+    if (uint64_t(junction.firstSignal) + junction.signalCount > header.signalCount)
+      throw BinaryScenarioReader::Exception("Invalid signal range in binary scenario.");
+
+    std::vector<Junction::Signal> signals;
+    signals.reserve(junction.signalCount);
+    for (std::size_t s = junction.firstSignal; s < junction.firstSignal + junction.signalCount; ++s) {
+      const auto signal = readRecord<Format::SignalRecord>(signalsOffset + s * sizeof(Format::SignalRecord));
+      if (signal.direction > WEST) throw BinaryScenarioReader::Exception("Invalid direction in signals list.");
+      signals.emplace_back(static_cast<CardinalDirection>(signal.direction), signal.duration);
+    }
+
+    junctions.push_back(
+        &domainModel.addJunction(Junction(0, junction.externalId, junction.x, junction.y, std::move(signals))));
+  }
+
+  std::vector<Street *> streets;
+  streets.reserve(header.streetCount);
+  for (std::size_t i = 0; i < header.streetCount; ++i) {
+    const auto street = readRecord<Format::StreetRecord>(streetsOffset + i * sizeof(Format::StreetRecord));
+    if (street.sourceJunction >= header.junctionCount || street.targetJunction >= header.junctionCount)
+      throw BinaryScenarioReader::Exception("Invalid junction index in binary street record.");
+
+    streets.push_back(&domainModel.addStreet(Street(0, street.lanes, street.speedLimit, street.length,
+        *junctions[street.sourceJunction], *junctions[street.targetJunction])));
+  }
+
+  for (std::size_t i = 0; i < header.junctionCount; ++i) {
+    const auto junction = readRecord<Format::JunctionRecord>(junctionsOffset + i * sizeof(Format::JunctionRecord));
+    for (unsigned direction = NORTH; direction <= WEST; ++direction) {
+      const uint32_t incoming = junction.incomingStreets[direction];
+      const uint32_t outgoing = junction.outgoingStreets[direction];
+      if ((incoming != Format::noElement && incoming >= header.streetCount) ||
+          (outgoing != Format::noElement && outgoing >= header.streetCount))
+        throw BinaryScenarioReader::Exception("Invalid street index in binary junction record.");
+
+      if (incoming != Format::noElement)
+        junctions[i]->addIncomingStreet(*streets[incoming], static_cast<CardinalDirection>(direction));
+      if (outgoing != Format::noElement)
+        junctions[i]->addOutgoingStreet(*streets[outgoing], static_cast<CardinalDirection>(direction));
+    }
+  }
+
+  std::unordered_set<int> vehicleIds;
+  for (std::size_t i = 0; i < header.vehicleCount; ++i) {
+    const auto vehicle = readRecord<Format::VehicleRecord>(vehiclesOffset + i * sizeof(Format::VehicleRecord));
+    if (vehicle.street >= header.streetCount)
+      throw BinaryScenarioReader::Exception("Invalid street index in binary vehicle record.");
+    if (uint64_t(vehicle.firstTurn) + vehicle.turnCount > header.turnCount)
+      throw BinaryScenarioReader::Exception("Invalid route range in binary scenario.");
+
+    Street &street = *streets[vehicle.street];
+    if (vehicle.lane >= street.getLanes())
+      throw BinaryScenarioReader::Exception("Invalid lane in vehicle position specification: no such lane on street.");
+    if (vehicle.distance < 0 || vehicle.distance > street.getLength())
+      throw BinaryScenarioReader::Exception("Invalid distance in vehicle position specification: not on street.");
+    if (vehicle.politeness < 0.0 || vehicle.politeness > 1.0)
+      throw BinaryScenarioReader::Exception("Invalid politeness in vehicle details.");
+
+    std::vector<TurnDirection> route;
+    route.reserve(vehicle.turnCount);
+    for (std::size_t t = vehicle.firstTurn; t < vehicle.firstTurn + vehicle.turnCount; ++t) {
+      const auto turn = readRecord<Format::TurnRecord>(turnsOffset + t);
+      if (turn > RIGHT) throw BinaryScenarioReader::Exception("Invalid turn direction in vehicle route.");
+      route.push_back(static_cast<TurnDirection>(turn));
+    }
+
+    if (!vehicleIds.insert(vehicle.externalId).second)
+      throw BinaryScenarioReader::Exception("Duplicate Vehicle ID encountered.");
+
+    Vehicle::Position position(street, vehicle.lane, vehicle.distance);
+    domainModel.addVehicle(Vehicle(0, vehicle.externalId, vehicle.targetVelocity, vehicle.maxAcceleration,
+        vehicle.targetDeceleration, vehicle.minDistance, vehicle.targetHeadway, vehicle.politeness, std::move(route),
+        position));
+  }
+
+  timeSteps         = header.timeSteps;
+  mode              = static_cast<Mode>(header.mode);
+  minTravelDistance = header.minTravelDistance;
+  hasBeenRead       = true;
+}
+
+unsigned int BinaryScenarioReader::getTimeSteps() const {
+  if (!hasBeenRead) throw BinaryScenarioReader::Exception("No input has been read yet.");
+
+  return timeSteps;
+}
+
+BinaryScenarioReader::Mode BinaryScenarioReader::getMode() const {
+  if (!hasBeenRead) throw BinaryScenarioReader::Exception("No input has been read yet.");
+
+  return mode;
+}
+
+unsigned int BinaryScenarioReader::getMinTravelDistance() const {
+  if (!hasBeenRead) throw BinaryScenarioReader::Exception("No input has been read yet.");
+
+  return minTravelDistance;
+}
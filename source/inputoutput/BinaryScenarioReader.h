@@ -0,0 +1,79 @@
+#ifndef BINARY_SCENARIO_READER_H
+#define BINARY_SCENARIO_READER_H
+
+#include <cstddef>
+#include <exception>
+#include <istream>
+#include <string>
+#include <vector>
+
+#include "DomainModel.h"
+#include "JSONReader.h"
+
+/**
+ * Reads scenarios in the binary format described in BinaryScenarioFormat.h.
+ *
+ * Regular files are mapped into memory, the records are copied from the mapping directly into the domain model without
+ * parsing. Other inputs like pipes are read into a buffer first.
+ */
+class BinaryScenarioReader {
+public:
+  class Exception : public std::exception {
+  protected:
+    std::string whatStr;
+
+  public:
+    Exception(const char *what);
+    virtual const char *what() const throw();
+  };
+
+  using Mode = JSONReader::Mode;
+
+private:
+  const char *data;
+  std::size_t size;
+  bool mapped;
+  std::vector<char> buffer;
+
+  bool hasBeenRead;
+  unsigned int timeSteps;
+  Mode mode;
+  unsigned int minTravelDistance;
+
+  template <typename Record>
+  Record readRecord(std::size_t offset) const;
+
+public:
+  /**
+   * Checks whether the descriptor refers to a regular file, which can be mapped into memory.
+   */
+  static bool isMappable(int fd);
+  /**
+   * Checks the magic at the beginning of the regular file 'fd' without changing its offset.
+   */
+  static bool isBinaryScenario(int fd);
+  /**
+   * Checks the first character of the stream without consuming it.
+   */
+  static bool isBinaryScenario(std::istream &in);
+
+  /**
+   * Maps the regular file 'fd' into memory. The descriptor may be closed afterwards.
+   */
+  explicit BinaryScenarioReader(int fd);
+  /**
+   * Reads the remaining stream into a buffer.
+   */
+  explicit BinaryScenarioReader(std::istream &in);
+  BinaryScenarioReader(const BinaryScenarioReader &other) = delete;
+  BinaryScenarioReader &operator=(const BinaryScenarioReader &other) = delete;
+  ~BinaryScenarioReader();
+
+  void readInto(DomainModel &domainModel);
+
+  unsigned int getTimeSteps() const;
+  Mode getMode() const;
+  unsigned int getMinTravelDistance() const;
+};
+
+#endif
@@ -0,0 +1,138 @@
+#include "BinaryScenarioWriter.h"
+
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <ostream>
+#include <vector>
+
+#include "BinaryScenarioFormat.h"
+#include "DomainModel.h"
+#include "DomainModelCommon.h"
+#include "Junction.h"
+#include "Street.h"
+#include "Vehicle.h"
+
+using Format = BinaryScenarioFormat;
+
+BinaryScenarioWriter::Exception::Exception(const char *_what) : whatStr(_what) {}
+
+const char *BinaryScenarioWriter::Exception::what() const throw() { return whatStr.c_str(); }
+
+BinaryScenarioWriter::BinaryScenarioWriter(std::ostream &_out) : out(_out) {}
+
+template <typename Record>
+static void writeTable(std::ostream &out, const std::vector<Record> &table) {
+  out.write(reinterpret_cast<const char *>(table.data()), table.size() * sizeof(Record));
+}
+
+void BinaryScenarioWriter::writeScenario(
+    const DomainModel &domainModel, JSONReader::Mode mode, unsigned int timeSteps, unsigned int minTravelDistance) {
+  if (!Format::isHostLittleEndian())
+    throw BinaryScenarioWriter::Exception("Binary scenarios are only supported on little-endian hosts.");
+
+  auto getStreetIndex = [](const auto &connectedStreet) -> uint32_t {
+    return connectedStreet.isConnected() ? connectedStreet.getStreet()->getId() : Format::noElement;
+  };
+
+  std::vector<Format::JunctionRecord> junctions;
+  std::vector<Format::SignalRecord> signals;
+  junctions.reserve(domainModel.getJunctions().size());
+  for (const auto &junction : domainModel.getJunctions()) {
+    Format::JunctionRecord record = {};
+    record.externalId             = junction.getExternalId();
+    record.x                      = junction.getX();
+    record.y                      = junction.getY();
+    record.firstSignal            = signals.size();
+    record.signalCount            = junction.getSignals().size();
+    for (unsigned direction = NORTH; direction <= WEST; ++direction) {
+      record.incomingStreets[direction] = getStreetIndex(junction.getIncomingStreets()[direction]);
+      record.outgoingStreets[direction] = getStreetIndex(junction.getOutgoingStreets()[direction]);
+    }
+    junctions.push_back(record);
+
+    for (const auto &signal : junction.getSignals()) {
+      signals.push_back(Format::SignalRecord{uint32_t(signal.getDirection()), signal.getDuration()});
+    }
+  }
+
+  std::vector<Format::StreetRecord> streets;
+  streets.reserve(domainModel.getStreets().size());
+  for (const auto &street : domainModel.getStreets()) {
+    Format::StreetRecord record = {};
+    record.lanes                = street.getLanes();
+    record.sourceJunction       = street.getSourceJunction().getId();
+    record.targetJunction       = street.getTargetJunction().getId();
+    record.speedLimit           = street.getSpeedLimit();
+    record.length               = street.getLength();
+    streets.push_back(record);
+  }
+
+  std::vector<Format::VehicleRecord> vehicles;
+  std::vector<Format::TurnRecord> turns;
+  vehicles.reserve(domainModel.getVehicles().size());
+  for (const auto &vehicle : domainModel.getVehicles()) {
+    Format::VehicleRecord record = {};
+    record.externalId            = vehicle.getExternalId();
+    record.street                = vehicle.getPosition().getStreet()->getId();
+    record.lane                  = vehicle.getPosition().getLane();
+    record.firstTurn             = turns.size();
+    record.turnCount             = vehicle.getRoute().size();
+    record.targetVelocity        = vehicle.getTargetVelocity();
+    record.maxAcceleration       = vehicle.getMaxAcceleration();
+    record.targetDeceleration    = vehicle.getTargetDeceleration();
+    record.minDistance           = vehicle.getMinDistance();
+    record.targetHeadway         = vehicle.getTargetHeadway();
+    record.politeness            = vehicle.getPoliteness();
+    record.distance              = vehicle.getPosition().getDistance();
+    vehicles.push_back(record);
+
+    for (TurnDirection turn : vehicle.getRoute()) { turns.push_back(turn); }
+  }
+
+  Format::Header header = {};
+  std::memcpy(header.magic, Format::magic, sizeof(Format::magic));
+  header.version           = Format::version;
+  header.mode              = mode;
+  header.timeSteps         = timeSteps;
+  header.minTravelDistance = minTravelDistance;
+  header.junctionCount     = junctions.size();
+  header.signalCount       = signals.size();
+  header.streetCount       = streets.size();
+  header.vehicleCount      = vehicles.size();
+  header.turnCount         = turns.size();
+  turns.resize(Format::paddedTurnTableSize(header.turnCount), 0);
+
+  out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+  writeTable(out, junctions);
+  writeTable(out, signals);
+  writeTable(out, streets);
+  writeTable(out, vehicles);
+  writeTable(out, turns);
+  out.flush();
+  if (!out) throw BinaryScenarioWriter::Exception("Writing the binary scenario failed.");
+}
+
+void BinaryScenarioWriter::writeVehicles(const DomainModel &domainModel) {
+  if (!Format::isHostLittleEndian())
+    throw BinaryScenarioWriter::Exception("Binary scenarios are only supported on little-endian hosts.");
+
+  std::vector<Format::VehiclePositionRecord> vehicles;
+  vehicles.reserve(domainModel.getVehicles().size());
+  for (const auto &vehicle : domainModel.getVehicles()) {
+    const Vehicle::Position &position = vehicle.getPosition();
+    vehicles.push_back(Format::VehiclePositionRecord{vehicle.getExternalId(),
+        position.getStreet()->getSourceJunction().getExternalId(),
+        position.getStreet()->getTargetJunction().getExternalId(), position.getLane(), position.getDistance()});
+  }
+
+  Format::ResultHeader header = {};
+  std::memcpy(header.magic, Format::resultMagic, sizeof(Format::resultMagic));
+  header.version      = Format::version;
+  header.vehicleCount = vehicles.size();
+
+  out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+  writeTable(out, vehicles);
+  out.flush();
+  if (!out) throw BinaryScenarioWriter::Exception("Writing the binary vehicle positions failed.");
+}
@@ -0,0 +1,39 @@
+#ifndef BINARY_SCENARIO_WRITER_H
+#define BINARY_SCENARIO_WRITER_H
+
+#include <exception>
+#include <ostream>
+#include <string>
+
+#include "DomainModel.h"
+#include "JSONReader.h"
+
+/**
+ * Writes a scenario in the binary format described in BinaryScenarioFormat.h, e.g. to convert a JSON scenario.
+ *
+ * For writeScenario the domain model is expected in its initial state as created by a reader: vehicles are written
+ * with their complete route and their current position. writeVehicles is the binary counterpart to
+ * JSONWriter::writeVehicles.
+ */
+class BinaryScenarioWriter {
+public:
+  class Exception : public std::exception {
+  protected:
+    std::string whatStr;
+
+  public:
+    Exception(const char *what);
+    virtual const char *what() const throw();
+  };
+
+private:
+  std::ostream &out;
+
+public:
+  BinaryScenarioWriter(std::ostream &out);
+  void writeScenario(const DomainModel &domainModel, JSONReader::Mode mode, unsigned int timeSteps,
+      unsigned int minTravelDistance);
+  void writeVehicles(const DomainModel &domainModel);
+};
+
+#endif
@@ -0,0 +1,88 @@
+#include "CheckpointFile.h"
+
+#include <cerrno>
+#include <cstdio>
+#include <exception>
+#include <functional>
+#include <ostream>
+#include <streambuf>
+#include <string>
+
+#include <fcntl.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+CheckpointFile::Exception::Exception(const char *_what) : whatStr(_what) {}
+
+const char *CheckpointFile::Exception::what() const throw() { return whatStr.c_str(); }
+
+CheckpointFile::CheckpointFile(const std::string &_path, unsigned int _interval)
+    : path(_path), temporaryPath(_path + ".tmp"), interval(_interval) {
+  if (interval == 0) throw CheckpointFile::Exception("The checkpoint interval must be positive.");
+}
+
+CheckpointFile::~CheckpointFile() {
+  if (writer > 0) waitpid(writer, nullptr, 0);
+}
+
+class CheckpointFile::AppendBuffer : public std::streambuf {
+private:
+  std::string &target;
+
+protected:
+  int_type overflow(int_type c) override {
+    if (!traits_type::eq_int_type(c, traits_type::eof())) target.push_back(traits_type::to_char_type(c));
+    return traits_type::not_eof(c);
+  }
+  std::streamsize xsputn(const char *s, std::streamsize n) override {
+    target.append(s, n);
+    return n;
+  }
+
+public:
+  AppendBuffer(std::string &_target) : target(_target) {}
+};
+
+bool CheckpointFile::writeFile() const {
+  // only async-signal-safe calls, see the class description
+  const int fd = open(temporaryPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  if (fd < 0) return false;
+  std::size_t written = 0;
+  while (written < buffer.size()) {
+    const ssize_t result = ::write(fd, buffer.data() + written, buffer.size() - written);
+    if (result < 0 && errno == EINTR) continue;
+    if (result <= 0) break;
+    written += result;
+  }
+  return close(fd) == 0 && written == buffer.size() && rename(temporaryPath.c_str(), path.c_str()) == 0;
+}
+
+void CheckpointFile::waitForWriter() {
+  if (writer <= 0) return;
+
+  int status;
+  const pid_t result = waitpid(writer, &status, 0);
+  writer             = -1;
+  if (result < 0 || !WIFEXITED(status) || WEXITSTATUS(status) != 0)
+    throw CheckpointFile::Exception("Writing the checkpoint failed.");
+}
+
+void CheckpointFile::write(const std::function<void(std::ostream &)> &writeContents) {
+  buffer.clear();
+  AppendBuffer streamBuffer(buffer);
+  std::ostream out(&streamBuffer);
+  writeContents(out);
+  if (!out) throw CheckpointFile::Exception("Serializing the checkpoint failed.");
+
+  // the previous child has its own copy of the buffer, but its rename must not overtake the next one
+  waitForWriter();
+
+  writer = fork();
+  // child: must not return into the simulation or run exit handlers of the parent
+  if (writer == 0) _exit(writeFile() ? 0 : 1);
+
+  if (writer < 0 && !writeFile()) throw CheckpointFile::Exception("Writing the checkpoint failed.");
+}
+
+void CheckpointFile::finish() { waitForWriter(); }
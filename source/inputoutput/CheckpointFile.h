@@ -0,0 +1,73 @@
+#ifndef CHECKPOINT_FILE_H
+#define CHECKPOINT_FILE_H
+
+#include <exception>
+#include <functional>
+#include <ostream>
+#include <string>
+
+#include <sys/types.h>
+
+/**
+ * Writes checkpoints of a running simulation to a file without stalling the simulation.
+ *
+ * Each checkpoint is serialized into a buffer by the calling process and written to the file by a forked child process,
+ * while the parent continues simulating. As the parent may run other threads, e.g. OpenMP workers or the trajectory
+ * writer, the child neither allocates nor uses streams, it only calls write() and rename(). It writes to a temporary
+ * file which replaces the checkpoint file once it is complete, i.e. the file always contains the last complete
+ * checkpoint. At most one child runs at a time, if fork() is not available the checkpoint is written by the calling
+ * process.
+ *
+ * The contents are written by ModelSyncer::writeCheckpoint, see BinaryScenarioFormat.h for the format.
+ */
+class CheckpointFile {
+public:
+  class Exception : public std::exception {
+  protected:
+    std::string whatStr;
+
+  public:
+    Exception(const char *what);
+    virtual const char *what() const throw();
+  };
+
+private:
+  /**
+   * Stream buffer appending to a string, which keeps its capacity when cleared.
+   */
+  class AppendBuffer;
+
+  const std::string path;
+  const std::string temporaryPath;
+  const unsigned int interval;
+  pid_t writer = -1;
+  // the serialized checkpoint, keeps its capacity between checkpoints
+  std::string buffer;
+
+  bool writeFile() const;
+  void waitForWriter();
+
+public:
+  /**
+   * @param[in]  path      The checkpoint file
+   * @param[in]  interval  The number of steps between two checkpoints
+   */
+  CheckpointFile(const std::string &path, unsigned int interval);
+  CheckpointFile(const CheckpointFile &other) = delete;
+  CheckpointFile &operator=(const CheckpointFile &other) = delete;
+  ~CheckpointFile();
+
+  unsigned int getInterval() const { return interval; }
+
+  /**
+   * Serializes a checkpoint and starts writing it, waits for the previous one to be complete first.
+   * @param[in]  writeContents  Writes the checkpoint to the given stream, called in the calling process
+   */
+  void write(const std::function<void(std::ostream &)> &writeContents);
+  /**
+   * Waits until the last checkpoint has been written.
+   */
+  void finish();
+};
+
+#endif
@@ -4,6 +4,8 @@
 #include <cstdlib>
 #include <exception>
 #include <iostream>
+#include <string>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
@@ -45,42 +47,127 @@ unsigned int JSONReader::getMinTravelDistance() const {
   return minTravelDistance;
 }
 
-void JSONReader::readInto(DomainModel &domainModel) {
-  if (hasBeenRead) throw JSONReader::Exception("Attempting to read input although input has already been read.");
+template <typename T>
+T JSONReader::Value::get(const char *field) const {
+  if (!present) throw JSONReader::Exception((std::string("Missing value for '") + field + "' in input.").c_str());
+  if (std::is_same<T, bool>::value != isBoolean)
+    throw JSONReader::Exception((std::string("Invalid type of value for '") + field + "' in input.").c_str());
+  return isFloat ? static_cast<T>(floating) : static_cast<T>(integer);
+}
 
-  json input;
+/**
+ * Keeps track of the position in the JSON document by a stack of contexts, e.g. a car object within the cars array.
+ * Values are stored in the record of the innermost junction, road or car object. Once such an object is complete, it is
+ * added to the domain model. Roads are delayed until all junctions have been read and cars until all roads have been
+ * read, the order of the top level keys is not fixed. Unknown keys are skipped.
+ */
+class JSONReader::SaxHandler {
+private:
+  enum Context { ROOT, JUNCTIONS, JUNCTION, SIGNALS, SIGNAL, ROADS, ROAD, CARS, CAR, START, ROUTE, SKIPPED };
 
-  // May throw exception
-  in >> input;
+  const JSONReader &reader;
+  DomainModel &domainModel;
 
-  timeSteps = input["time_steps"].get<unsigned int>();
+  std::vector<Context> contexts;
+  std::string currentKey;
 
-  if (input.count("optimize_signals") > 0) {
-    if (input["optimize_signals"].get<bool>())
-      mode = JSONReader::OPTIMIZE;
-    else
-      mode = JSONReader::SIMULATE;
-  } else {
-    mode = JSONReader::SIMULATE;
-  }
+  JunctionRecord junction;
+  RoadRecord road;
+  VehicleRecord vehicle;
 
-  if (mode == JSONReader::OPTIMIZE) minTravelDistance = input["min_travel_distance"].get<unsigned int>();
+  bool junctionsComplete = false;
+  bool roadsComplete     = false;
+  std::vector<RoadRecord> pendingRoads;
+  std::vector<VehicleRecord> pendingVehicles;
 
   std::map<int, Junction *> junctionsMap;
   std::map<int, Vehicle *> vehiclesMap;
 
-  for (const auto &inputJunction : input["junctions"]) {
-    Junction junction = readJunction(inputJunction, mode);
+public:
+  Value timeSteps;
+  Value optimizeSignals;
+  Value minTravelDistance;
+  // the first error in a signals list, only reported in SIMULATE mode
+  std::string signalError;
+
+private:
+  Context context() const { return contexts.empty() ? SKIPPED : contexts.back(); }
+
+  /**
+   * Returns the value the current key refers to in the current context, nullptr if the value is not used.
+   */
+  Value *getTarget() {
+    switch (context()) {
+    case ROOT:
+      if (currentKey == "time_steps") return &timeSteps;
+      if (currentKey == "optimize_signals") return &optimizeSignals;
+      if (currentKey == "min_travel_distance") return &minTravelDistance;
+      return nullptr;
+    case JUNCTION:
+      if (currentKey == "id") return &junction.id;
+      if (currentKey == "x") return &junction.x;
+      if (currentKey == "y") return &junction.y;
+      return nullptr;
+    case SIGNAL:
+      if (currentKey == "dir") return &junction.signals.back().first;
+      if (currentKey == "time") return &junction.signals.back().second;
+      return nullptr;
+    case ROAD:
+      if (currentKey == "junction1") return &road.junction1;
+      if (currentKey == "junction2") return &road.junction2;
+      if (currentKey == "lanes") return &road.lanes;
+      if (currentKey == "limit") return &road.limit;
+      return nullptr;
+    case CAR:
+      if (currentKey == "id") return &vehicle.id;
+      if (currentKey == "target_velocity") return &vehicle.targetVelocity;
+      if (currentKey == "max_acceleration") return &vehicle.maxAcceleration;
+      if (currentKey == "target_deceleration") return &vehicle.targetDeceleration;
+      if (currentKey == "min_distance") return &vehicle.minDistance;
+      if (currentKey == "target_headway") return &vehicle.targetHeadway;
+      if (currentKey == "politeness") return &vehicle.politeness;
+      return nullptr;
+    case START:
+      if (currentKey == "from") return &vehicle.from;
+      if (currentKey == "to") return &vehicle.to;
+      if (currentKey == "lane") return &vehicle.lane;
+      if (currentKey == "distance") return &vehicle.distance;
+      return nullptr;
+    case ROUTE: vehicle.route.emplace_back(); return &vehicle.route.back();
+    default: return nullptr;
+    }
+  }
+
+  bool setValue(const bool isBoolean, const bool isFloat, const long long integer, const double floating) {
+    Value *target = getTarget();
+    if (target != nullptr) {
+      target->present   = true;
+      target->isBoolean = isBoolean;
+      target->isFloat   = isFloat;
+      target->integer  = integer;
+      target->floating = floating;
+    }
+    return true;
+  }
+
+  void addJunction() {
+    std::vector<Junction::Signal> signals;
+    try {
+      signals = reader.readSignals(junction);
+    } catch (const JSONReader::Exception &exception) {
+      if (signalError.empty()) signalError = exception.what();
+    }
+    Junction newJunction = reader.readJunction(junction, std::move(signals));
 
-    if (junctionsMap.count(junction.getExternalId()) > 0)
+    if (junctionsMap.count(newJunction.getExternalId()) > 0)
       throw JSONReader::Exception("Duplicate Junction ID encountered.");
 
-    Junction &domainJunction                     = domainModel.addJunction(std::move(junction));
+    Junction &domainJunction                     = domainModel.addJunction(std::move(newJunction));
     junctionsMap[domainJunction.getExternalId()] = &domainJunction;
   }
 
-  for (const auto &inputRoad : input["roads"]) {
-    Road road = readRoad(inputRoad, junctionsMap);
+  void addRoad(const RoadRecord &inputRoad) {
+    Road road = reader.readRoad(inputRoad, junctionsMap);
 
     Street street1(0, road.lanes, road.speedLimit, road.length, road.junction1, road.junction2);
     Street &domainStreet1 = domainModel.addStreet(std::move(street1));
@@ -88,59 +175,216 @@ void JSONReader::readInto(DomainModel &domainModel) {
     Street street2(0, road.lanes, road.speedLimit, road.length, road.junction2, road.junction1);
     Street &domainStreet2 = domainModel.addStreet(std::move(street2));
 
-    road.junction1.addOutgoingStreet(domainStreet1, relativeDirection(road.junction1, road.junction2));
-    road.junction2.addIncomingStreet(domainStreet1, relativeDirection(road.junction2, road.junction1));
+    road.junction1.addOutgoingStreet(domainStreet1, reader.relativeDirection(road.junction1, road.junction2));
+    road.junction2.addIncomingStreet(domainStreet1, reader.relativeDirection(road.junction2, road.junction1));
 
-    road.junction2.addOutgoingStreet(domainStreet2, relativeDirection(road.junction2, road.junction1));
-    road.junction1.addIncomingStreet(domainStreet2, relativeDirection(road.junction1, road.junction2));
+    road.junction2.addOutgoingStreet(domainStreet2, reader.relativeDirection(road.junction2, road.junction1));
+    road.junction1.addIncomingStreet(domainStreet2, reader.relativeDirection(road.junction1, road.junction2));
   }
 
-  for (const auto &inputVehicle : input["cars"]) {
-    Vehicle vehicle = readVehicle(inputVehicle, junctionsMap);
+  void addVehicle(const VehicleRecord &inputVehicle) {
+    Vehicle newVehicle = reader.readVehicle(inputVehicle, junctionsMap);
 
-    if (vehiclesMap.count(vehicle.getExternalId()) > 0)
+    if (vehiclesMap.count(newVehicle.getExternalId()) > 0)
       throw JSONReader::Exception("Duplicate Vehicle ID encountered.");
 
-    Vehicle &domainVehicle                     = domainModel.addVehicle(std::move(vehicle));
+    Vehicle &domainVehicle                     = domainModel.addVehicle(std::move(newVehicle));
     vehiclesMap[domainVehicle.getExternalId()] = &domainVehicle;
   }
 
-  hasBeenRead = true;
-}
+  /** Adds the delayed roads and cars once the objects they refer to are complete. */
+  void addPending() {
+    if (!junctionsComplete) return;
+    for (const auto &pendingRoad : pendingRoads) addRoad(pendingRoad);
+    pendingRoads.clear();
 
-Junction JSONReader::readJunction(const json &inputJunction, JSONReader::Mode mode) const {
-  int externalId = inputJunction["id"].get<int>();
-  int x          = inputJunction["x"].get<int>();
-  int y          = inputJunction["y"].get<int>();
+    if (!roadsComplete) return;
+    for (const auto &pendingVehicle : pendingVehicles) addVehicle(pendingVehicle);
+    pendingVehicles.clear();
+  }
 
-  std::vector<Junction::Signal> signals;
+public:
+  SaxHandler(const JSONReader &_reader, DomainModel &_domainModel) : reader(_reader), domainModel(_domainModel) {}
+
+  /** Adds all delayed objects, missing arrays are treated as empty. */
+  void finish() {
+    junctionsComplete = true;
+    roadsComplete     = true;
+    addPending();
+  }
+
+  // nlohmann::json SAX interface
+  bool null() { return true; }
+  bool boolean(bool value) { return setValue(true, false, value, value); }
+  bool number_integer(json::number_integer_t value) { return setValue(false, false, value, value); }
+  bool number_unsigned(json::number_unsigned_t value) { return setValue(false, false, value, value); }
+  bool number_float(json::number_float_t value, const json::string_t &) {
+    return setValue(false, true, static_cast<long long>(value), value);
+  }
+  bool string(json::string_t &) {
+    if (getTarget() != nullptr) {
+      throw JSONReader::Exception(("Invalid string value for '" + currentKey + "' in input.").c_str());
+    }
+    return true;
+  }
+  template <typename Binary>
+  bool binary(Binary &) {
+    return true;
+  }
+
+  bool key(json::string_t &value) {
+    currentKey = value;
+    return true;
+  }
+
+  bool start_object(std::size_t) {
+    if (contexts.empty()) {
+      contexts.push_back(ROOT);
+    } else if (context() == JUNCTIONS) {
+      junction = JunctionRecord();
+      contexts.push_back(JUNCTION);
+    } else if (context() == SIGNALS) {
+      junction.signals.emplace_back();
+      contexts.push_back(SIGNAL);
+    } else if (context() == ROADS) {
+      road = RoadRecord();
+      contexts.push_back(ROAD);
+    } else if (context() == CARS) {
+      vehicle = VehicleRecord();
+      contexts.push_back(CAR);
+    } else if (context() == CAR && currentKey == "start") {
+      contexts.push_back(START);
+    } else {
+      contexts.push_back(SKIPPED);
+    }
+    return true;
+  }
 
-  if (mode == JSONReader::SIMULATE) {
-    signals.reserve(inputJunction["signals"].size());
+  bool end_object() {
+    Context completed = context();
+    contexts.pop_back();
+    if (completed == JUNCTION) {
+      addJunction();
+    } else if (completed == ROAD) {
+      if (junctionsComplete) {
+        addRoad(road);
+      } else {
+        pendingRoads.push_back(road);
+      }
+    } else if (completed == CAR) {
+      if (junctionsComplete && roadsComplete) {
+        addVehicle(vehicle);
+      } else {
+        pendingVehicles.push_back(vehicle);
+      }
+    }
+    return true;
+  }
 
-    for (const auto &inputSignal : inputJunction["signals"]) {
-      // 0->North, 1->East, 2->South, 3->West
-      unsigned int direction = inputSignal["dir"].get<unsigned int>();
-      if (direction > WEST) throw JSONReader::Exception("Invalid direction in signals list.");
-      // Input in s
-      unsigned int time = inputSignal["time"].get<unsigned int>();
+  bool start_array(std::size_t) {
+    if (context() == ROOT && currentKey == "junctions") {
+      contexts.push_back(JUNCTIONS);
+    } else if (context() == ROOT && currentKey == "roads") {
+      contexts.push_back(ROADS);
+    } else if (context() == ROOT && currentKey == "cars") {
+      contexts.push_back(CARS);
+    } else if (context() == JUNCTION && currentKey == "signals") {
+      junction.signals.clear();
+      contexts.push_back(SIGNALS);
+    } else if (context() == CAR && currentKey == "route") {
+      vehicle.route.clear();
+      contexts.push_back(ROUTE);
+    } else {
+      contexts.push_back(SKIPPED);
+    }
+    return true;
+  }
 
-      Junction::Signal signal(static_cast<CardinalDirection>(direction), time);
-      signals.push_back(signal);
+  bool end_array() {
+    Context completed = context();
+    contexts.pop_back();
+    if (completed == JUNCTIONS) {
+      junctionsComplete = true;
+      addPending();
+    } else if (completed == ROADS) {
+      roadsComplete = true;
+      addPending();
     }
+    return true;
+  }
+
+  template <typename Exception>
+  bool parse_error(std::size_t, const std::string &, const Exception &exception) {
+    throw JSONReader::Exception(exception.what());
+  }
+};
+
+void JSONReader::readInto(DomainModel &domainModel) {
+  if (hasBeenRead) throw JSONReader::Exception("Attempting to read input although input has already been read.");
+
+  SaxHandler handler(*this, domainModel);
+
+  // May throw exception, trailing input after the top level value is ignored
+  json::sax_parse(in, &handler, json::input_format_t::json, false);
+  handler.finish();
+
+  timeSteps = handler.timeSteps.get<unsigned int>("time_steps");
+
+  if (handler.optimizeSignals.present) {
+    if (handler.optimizeSignals.get<bool>("optimize_signals"))
+      mode = JSONReader::OPTIMIZE;
+    else
+      mode = JSONReader::SIMULATE;
+  } else {
+    mode = JSONReader::SIMULATE;
+  }
+
+  if (mode == JSONReader::OPTIMIZE) {
+    minTravelDistance = handler.minTravelDistance.get<unsigned int>("min_travel_distance");
+    // signals given in the input are not used for optimization
+    for (auto &junction : domainModel.getJunctions()) { junction.setSignals(std::vector<Junction::Signal>()); }
+  } else if (!handler.signalError.empty()) {
+    throw JSONReader::Exception(handler.signalError.c_str());
   }
 
+  hasBeenRead = true;
+}
+
+Junction JSONReader::readJunction(const JunctionRecord &inputJunction, std::vector<Junction::Signal> signals) const {
+  int externalId = inputJunction.id.get<int>("id");
+  int x          = inputJunction.x.get<int>("x");
+  int y          = inputJunction.y.get<int>("y");
+
   return Junction(0, externalId, x, y, std::move(signals));
 }
 
-JSONReader::Road JSONReader::readRoad(const json &inputRoad, const std::map<int, Junction *> &junctionsMap) const {
+std::vector<Junction::Signal> JSONReader::readSignals(const JunctionRecord &inputJunction) const {
+  std::vector<Junction::Signal> signals;
+  signals.reserve(inputJunction.signals.size());
+
+  for (const auto &inputSignal : inputJunction.signals) {
+    // 0->North, 1->East, 2->South, 3->West
+    unsigned int direction = inputSignal.first.get<unsigned int>("dir");
+    if (direction > WEST) throw JSONReader::Exception("Invalid direction in signals list.");
+    // Input in s
+    unsigned int time = inputSignal.second.get<unsigned int>("time");
+
+    Junction::Signal signal(static_cast<CardinalDirection>(direction), time);
+    signals.push_back(signal);
+  }
+
+  return signals;
+}
+
+JSONReader::Road JSONReader::readRoad(
+    const RoadRecord &inputRoad, const std::map<int, Junction *> &junctionsMap) const {
   // junction IDs
-  int junctionId1 = inputRoad["junction1"].get<int>();
-  int junctionId2 = inputRoad["junction2"].get<int>();
+  int junctionId1 = inputRoad.junction1.get<int>("junction1");
+  int junctionId2 = inputRoad.junction2.get<int>("junction2");
   // Number of lanes into each direction; 1, 2 or 3
-  unsigned int lanes = inputRoad["lanes"].get<unsigned int>();
+  unsigned int lanes = inputRoad.lanes.get<unsigned int>("lanes");
   // Input in km/h
-  double speedLimit = kmhToMs(inputRoad["limit"].get<double>());
+  double speedLimit = kmhToMs(inputRoad.limit.get<double>("limit"));
 
   Junction *junction1 = junctionsMap.at(junctionId1);
   Junction *junction2 = junctionsMap.at(junctionId2);
@@ -150,29 +394,30 @@ JSONReader::Road JSONReader::readRoad(const json &inputRoad, const std::map<int,
   return JSONReader::Road(*junction1, *junction2, length, lanes, speedLimit);
 }
 
-Vehicle JSONReader::readVehicle(const json &inputVehicle, const std::map<int, Junction *> &junctionsMap) const {
-  int externalId = inputVehicle["id"].get<int>();
+Vehicle JSONReader::readVehicle(
+    const VehicleRecord &inputVehicle, const std::map<int, Junction *> &junctionsMap) const {
+  int externalId = inputVehicle.id.get<int>("id");
   // Input in km/h
-  double targetVelocity = kmhToMs(inputVehicle["target_velocity"].get<double>());
+  double targetVelocity = kmhToMs(inputVehicle.targetVelocity.get<double>("target_velocity"));
   // Input in m/s²
-  double maxAcceleration = inputVehicle["max_acceleration"].get<double>();
+  double maxAcceleration = inputVehicle.maxAcceleration.get<double>("max_acceleration");
   // Input in m/s²
-  double targetDeceleration = inputVehicle["target_deceleration"].get<double>();
+  double targetDeceleration = inputVehicle.targetDeceleration.get<double>("target_deceleration");
   // Input in m
-  double minDistance = inputVehicle["min_distance"].get<double>();
+  double minDistance = inputVehicle.minDistance.get<double>("min_distance");
   // Input in s
-  double targetHeadway = inputVehicle["target_headway"].get<double>();
+  double targetHeadway = inputVehicle.targetHeadway.get<double>("target_headway");
   // Input in range [0.0, 1.0]
-  double politeness = inputVehicle["politeness"].get<double>();
+  double politeness = inputVehicle.politeness.get<double>("politeness");
   if (politeness < 0.0 || politeness > 1.0) throw JSONReader::Exception("Invalid politeness in vehicle details.");
 
   // starting position via junction IDs
-  int fromJunctionId = inputVehicle["start"]["from"].get<int>();
-  int toJunctionId   = inputVehicle["start"]["to"].get<int>();
+  int fromJunctionId = inputVehicle.from.get<int>("from");
+  int toJunctionId   = inputVehicle.to.get<int>("to");
   // Lane on street
-  unsigned int lane = inputVehicle["start"]["lane"].get<unsigned int>();
+  unsigned int lane = inputVehicle.lane.get<unsigned int>("lane");
   // distance from 'from' junction in m
-  double distance = inputVehicle["start"]["distance"].get<double>();
+  double distance = inputVehicle.distance.get<double>("distance");
 
   Junction *fromJunction = junctionsMap.at(fromJunctionId);
 
@@ -200,11 +445,11 @@ Vehicle JSONReader::readVehicle(const json &inputVehicle, const std::map<int, Ju
   Vehicle::Position position(*street, lane, distance);
 
   std::vector<TurnDirection> route;
-  route.reserve(inputVehicle["route"].size());
+  route.reserve(inputVehicle.route.size());
 
-  for (const auto &inputTurn : inputVehicle["route"]) {
+  for (const auto &inputTurn : inputVehicle.route) {
     // turn order: 0->uturn, 1->left, 2->straight, 3->right
-    unsigned int turnDirection = inputTurn.get<unsigned int>();
+    unsigned int turnDirection = inputTurn.get<unsigned int>("route");
     if (turnDirection > RIGHT) throw JSONReader::Exception("Invalid turn direction in vehicle route.");
     route.push_back(static_cast<TurnDirection>(turnDirection));
   }
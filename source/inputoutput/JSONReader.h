@@ -3,9 +3,10 @@
 
 #include <exception>
 #include <istream>
+#include <map>
 #include <string>
-
-#include "../../json/single_include/nlohmann/json.hpp"
+#include <utility>
+#include <vector>
 
 #include "DomainModel.h"
 #include "Junction.h"
@@ -41,6 +42,42 @@ private:
     Road(Junction &junction1, Junction &junction2, double length, unsigned int lanes, double speedLimit);
   };
 
+  /**
+   * A numeric or boolean value as read from the JSON input, converted on access like nlohmann::json::get, i.e. booleans
+   * are only accepted for bool and numbers only for numeric types.
+   */
+  struct Value {
+    bool present      = false;
+    bool isBoolean    = false;
+    bool isFloat      = false;
+    long long integer = 0;
+    double floating   = 0;
+
+    template <typename T>
+    T get(const char *field) const;
+  };
+
+  /**
+   * The fields of the junction, road and car objects in the JSON input, filled while parsing.
+   */
+  struct JunctionRecord {
+    Value id, x, y;
+    std::vector<std::pair<Value, Value>> signals; // direction and time
+  };
+  struct RoadRecord {
+    Value junction1, junction2, lanes, limit;
+  };
+  struct VehicleRecord {
+    Value id, targetVelocity, maxAcceleration, targetDeceleration, minDistance, targetHeadway, politeness;
+    Value from, to, lane, distance;
+    std::vector<Value> route;
+  };
+
+  /**
+   * SAX event handler for nlohmann::json::sax_parse building the domain model while the input is parsed.
+   */
+  class SaxHandler;
+
 private:
   std::istream &in;
   bool hasBeenRead;
@@ -65,12 +102,25 @@ private:
    */
   CardinalDirection relativeDirection(Junction &origin, Junction &other) const;
 
-  Junction readJunction(const nlohmann::json &inputJunction, Mode mode) const;
-  Road readRoad(const nlohmann::json &inputRoad, const std::map<int, Junction *> &junctionsMap) const;
-  Vehicle readVehicle(const nlohmann::json &inputVehicle, const std::map<int, Junction *> &junctionsMap) const;
+  /**
+   * Creates a junction with the given signals from the given record.
+   */
+  Junction readJunction(const JunctionRecord &inputJunction, std::vector<Junction::Signal> signals) const;
+  /**
+   * Reads the signals of the given record. Signals are only required in SIMULATE mode, errors are therefore reported
+   * by readInto once the mode is known.
+   */
+  std::vector<Junction::Signal> readSignals(const JunctionRecord &inputJunction) const;
+  Road readRoad(const RoadRecord &inputRoad, const std::map<int, Junction *> &junctionsMap) const;
+  Vehicle readVehicle(const VehicleRecord &inputVehicle, const std::map<int, Junction *> &junctionsMap) const;
 
 public:
   JSONReader(std::istream &in);
+  /**
+   * Reads the input into the given domain model.
+   * The input is parsed as a stream without building a JSON document first: junctions, streets and vehicles are added
+   * to the domain model as soon as their JSON object is complete and the objects they refer to have been read.
+   */
   void readInto(DomainModel &domainModel);
   /**
    * Returns the time_steps specified in a file read.
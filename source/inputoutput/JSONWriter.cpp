@@ -1,7 +1,11 @@
 #include "JSONWriter.h"
 
+#include <charconv>
+#include <cmath>
+#include <cstring>
 #include <exception>
 #include <iostream>
+#include <vector>
 
 #include "../../json/single_include/nlohmann/json.hpp"
 
@@ -15,24 +19,88 @@ const char *JSONWriter::Exception::what() const throw() { return whatStr.c_str()
 
 JSONWriter::JSONWriter(std::ostream &_out) : out(_out) {}
 
+/**
+ * Collects the output in a buffer which is written to the stream whenever it is full. Numbers are formatted directly
+ * into the buffer without creating json values.
+ */
+class JSONWriter::OutputBuffer {
+private:
+  // large enough for any single number
+  static const std::size_t reserve = 64;
+
+  std::ostream &out;
+  std::vector<char> buffer;
+  std::size_t used = 0;
+
+public:
+  OutputBuffer(std::ostream &_out, std::size_t capacity) : out(_out), buffer(capacity + reserve) {}
+
+  void flush() {
+    out.write(buffer.data(), used);
+    used = 0;
+  }
+
+  /** Writes the buffer to the stream if there is no space left for another number. */
+  void flushIfFull() {
+    if (used + reserve > buffer.size()) flush();
+  }
+
+  /** Appends a short text, at most as long as the space reserved for a number. */
+  void append(const char *text, std::size_t length) {
+    flushIfFull();
+    std::memcpy(buffer.data() + used, text, length);
+    used += length;
+  }
+
+  template <std::size_t N>
+  void append(const char (&text)[N]) {
+    append(text, N - 1);
+  }
+
+  void appendInteger(long long value) {
+    flushIfFull();
+    used = std::to_chars(buffer.data() + used, buffer.data() + buffer.size(), value).ptr - buffer.data();
+  }
+
+  /**
+   * Formats the value exactly like nlohmann::json::dump, i.e. the output is byte for byte the same as before.
+   */
+  void appendDouble(double value) {
+    flushIfFull();
+    if (!std::isfinite(value)) {
+      append("null");
+      return;
+    }
+    used = nlohmann::detail::to_chars(buffer.data() + used, buffer.data() + buffer.size(), value) - buffer.data();
+  }
+};
+
 void JSONWriter::writeVehicles(DomainModel &domainModel) {
-  json output;
-  output["cars"] = json(json::value_t::array);
+  OutputBuffer output(out, 1 << 20);
+  output.append("{\"cars\":[");
 
+  bool first = true;
   for (const auto &vehicle : domainModel.getVehicles()) {
-    json outputCar;
-
-    outputCar["id"] = vehicle->getExternalId();
+    // keys in alphabetical order like nlohmann::json
+    if (!first) output.append(",");
+    first = false;
+    output.append("{\"from\":");
     // junction IDs
-    outputCar["from"] = vehicle->getPosition().getStreet()->getSourceJunction().getExternalId();
-    outputCar["to"]   = vehicle->getPosition().getStreet()->getTargetJunction().getExternalId();
-    outputCar["lane"] = vehicle->getPosition().getLane();
+    output.appendInteger(vehicle.getPosition().getStreet()->getSourceJunction().getExternalId());
+    output.append(",\"id\":");
+    output.appendInteger(vehicle.getExternalId());
+    output.append(",\"lane\":");
+    output.appendInteger(vehicle.getPosition().getLane());
     // Output in m
-    outputCar["position"] = vehicle->getPosition().getDistance();
-
-    output["cars"].push_back(outputCar);
+    output.append(",\"position\":");
+    output.appendDouble(vehicle.getPosition().getDistance());
+    output.append(",\"to\":");
+    output.appendInteger(vehicle.getPosition().getStreet()->getTargetJunction().getExternalId());
+    output.append("}");
   }
-  out << output.dump() << "\n";
+
+  output.append("]}\n");
+  output.flush();
 }
 
 void JSONWriter::writeSignals(DomainModel &domainModel) {
@@ -42,11 +110,11 @@ void JSONWriter::writeSignals(DomainModel &domainModel) {
   for (const auto &junction : domainModel.getJunctions()) {
     json outputJunction;
 
-    outputJunction["id"] = junction->getExternalId();
+    outputJunction["id"] = junction.getExternalId();
     // signals
     outputJunction["signals"] = json(json::value_t::array);
     json &outputSignals       = outputJunction["signals"];
-    for (const auto &signal : junction->getSignals()) {
+    for (const auto &signal : junction.getSignals()) {
       json outputSignal;
 
       outputSignal["dir"]  = static_cast<int>(signal.getDirection());
@@ -19,10 +19,15 @@ public:
   };
 
 private:
+  class OutputBuffer;
+
   std::ostream &out;
 
 public:
   JSONWriter(std::ostream &out);
+  /**
+   * Writes the positions of all vehicles. The output is streamed in chunks instead of building a JSON document first.
+   */
   void writeVehicles(DomainModel &domainModel);
   void writeSignals(DomainModel &domainModel);
 };
@@ -0,0 +1,99 @@
+#include "TrajectoryWriter.h"
+
+#include <cstring>
+#include <exception>
+#include <mutex>
+#include <ostream>
+#include <thread>
+
+#include "BinaryScenarioFormat.h"
+
+using Format = BinaryScenarioFormat;
+
+TrajectoryWriter::Exception::Exception(const char *_what) : whatStr(_what) {}
+
+const char *TrajectoryWriter::Exception::what() const throw() { return whatStr.c_str(); }
+
+TrajectoryWriter::TrajectoryWriter(std::ostream &_out, unsigned int vehicleCount, unsigned int _interval)
+    : out(_out), interval(_interval), finished(false), failed(false) {
+  if (!Format::isHostLittleEndian())
+    throw TrajectoryWriter::Exception("Binary trajectories are only supported on little-endian hosts.");
+  if (interval == 0) throw TrajectoryWriter::Exception("The trajectory interval must be positive.");
+
+  Format::TrajectoryHeader header = {};
+  std::memcpy(header.magic, Format::trajectoryMagic, sizeof(Format::trajectoryMagic));
+  header.version      = Format::version;
+  header.vehicleCount = vehicleCount;
+  header.interval     = interval;
+  out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+
+  for (unsigned int i = 0; i < frames.size(); ++i) {
+    frames[i].positions.reserve(vehicleCount);
+    frameReady[i] = false;
+  }
+
+  writerThread = std::thread(&TrajectoryWriter::writeFrames, this);
+}
+
+TrajectoryWriter::~TrajectoryWriter() { stopWriterThread(); }
+
+void TrajectoryWriter::stopWriterThread() {
+  if (!writerThread.joinable()) return;
+
+  // the writer thread only stops once it finds no ready frame after seeing finished, the frames submitted before are
+  // visible to it then
+  finished = true;
+  { std::lock_guard<std::mutex> lock(mutex); }
+  frameSubmitted.notify_one();
+  writerThread.join();
+}
+
+void TrajectoryWriter::writeFrames() {
+  while (true) {
+    if (!frameReady[nextWrittenFrame].load(std::memory_order_acquire)) {
+      // the last frame may have been submitted between both loads
+      if (finished && !frameReady[nextWrittenFrame].load(std::memory_order_acquire)) return;
+      std::unique_lock<std::mutex> lock(mutex);
+      frameSubmitted.wait(lock, [this] { return frameReady[nextWrittenFrame] || finished; });
+      continue;
+    }
+
+    const Frame &frame = frames[nextWrittenFrame];
+    Format::FrameHeader header{frame.step, static_cast<uint32_t>(frame.positions.size())};
+    out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char *>(frame.positions.data()),
+        frame.positions.size() * sizeof(Format::VehiclePositionRecord));
+    if (!out) failed = true;
+
+    frameReady[nextWrittenFrame].store(false, std::memory_order_release);
+    nextWrittenFrame = (nextWrittenFrame + 1) % frames.size();
+    { std::lock_guard<std::mutex> lock(mutex); }
+    frameWritten.notify_one();
+  }
+}
+
+TrajectoryWriter::Frame &TrajectoryWriter::beginFrame(unsigned int step) {
+  if (frameReady[nextFilledFrame].load(std::memory_order_acquire)) {
+    std::unique_lock<std::mutex> lock(mutex);
+    frameWritten.wait(lock, [this] { return !frameReady[nextFilledFrame]; });
+  }
+
+  Frame &frame = frames[nextFilledFrame];
+  frame.step   = step;
+  frame.positions.clear();
+  return frame;
+}
+
+void TrajectoryWriter::submitFrame() {
+  frameReady[nextFilledFrame].store(true, std::memory_order_release);
+  nextFilledFrame = (nextFilledFrame + 1) % frames.size();
+  { std::lock_guard<std::mutex> lock(mutex); }
+  frameSubmitted.notify_one();
+}
+
+void TrajectoryWriter::finish() {
+  stopWriterThread();
+
+  out.flush();
+  if (failed || !out) throw TrajectoryWriter::Exception("Writing the trajectory failed.");
+}
@@ -0,0 +1,91 @@
+#ifndef TRAJECTORY_WRITER_H
+#define TRAJECTORY_WRITER_H
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "BinaryScenarioFormat.h"
+
+/**
+ * Writes the vehicle positions of intermediate simulation steps to a stream in the background.
+ *
+ * The simulation fills a frame with the positions of all vehicles and submits it, a writer thread writes the frame
+ * while the simulation continues. There are two frames which are handed over between the threads by atomic flags, the
+ * simulation only waits if it submits frames faster than they can be written. The mutex and condition variables are
+ * only used to put an idle thread to sleep.
+ *
+ * Output format: a BinaryScenarioFormat::TrajectoryHeader followed by one FrameHeader and the vehicle positions per
+ * frame, see tools/trajectory.py for converting it into the JSON output format.
+ */
+class TrajectoryWriter {
+public:
+  class Exception : public std::exception {
+  protected:
+    std::string whatStr;
+
+  public:
+    Exception(const char *what);
+    virtual const char *what() const throw();
+  };
+
+  struct Frame {
+    unsigned int step;
+    std::vector<BinaryScenarioFormat::VehiclePositionRecord> positions;
+  };
+
+private:
+  std::ostream &out;
+  const unsigned int interval;
+
+  std::array<Frame, 2> frames;
+  // set by the simulation once a frame is complete, reset by the writer thread once it has been written
+  std::array<std::atomic<bool>, 2> frameReady;
+  unsigned int nextFilledFrame  = 0;
+  unsigned int nextWrittenFrame = 0;
+  std::atomic<bool> finished;
+  std::atomic<bool> failed;
+
+  std::mutex mutex;
+  std::condition_variable frameSubmitted;
+  std::condition_variable frameWritten;
+  std::thread writerThread;
+
+  void writeFrames();
+  void stopWriterThread();
+
+public:
+  /**
+   * Writes the header and starts the writer thread.
+   * @param[in]  out           The stream to write to, must not be used by others until finish() is called
+   * @param[in]  vehicleCount  The number of vehicles, used to reserve the frames
+   * @param[in]  interval      The number of steps between two frames
+   */
+  TrajectoryWriter(std::ostream &out, unsigned int vehicleCount, unsigned int interval);
+  TrajectoryWriter(const TrajectoryWriter &other) = delete;
+  TrajectoryWriter &operator=(const TrajectoryWriter &other) = delete;
+  ~TrajectoryWriter();
+
+  unsigned int getInterval() const { return interval; }
+
+  /**
+   * Returns the frame to be filled next, waits until the writer thread has written its previous contents.
+   */
+  Frame &beginFrame(unsigned int step);
+  /**
+   * Hands the frame returned by beginFrame over to the writer thread.
+   */
+  void submitFrame();
+  /**
+   * Waits until all submitted frames have been written and stops the writer thread.
+   */
+  void finish();
+};
+
+#endif
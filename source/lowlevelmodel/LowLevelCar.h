@@ -39,6 +39,7 @@ private:
    */
 
   unsigned int currentLane;
+  unsigned int routeIndex = 0; // position in the route, i.e. index of the next turn (fills the padding after the lane)
   double currentDistance;
   double currentVelocity;
 
@@ -51,6 +52,8 @@ private:
 
   double nextBaseAcceleration; // Re-used by other cars.
   unsigned int nextLane;
+  // whether lane or distance changed since the position was last written to the domain model (fills the padding)
+  bool positionChanged = true;
   double nextDistance;
   double nextVelocity;
 
@@ -100,6 +103,7 @@ public:
    * time step are then available through getDistance(), ...
    */
   void update() {
+    positionChanged = positionChanged || currentLane != nextLane || currentDistance != nextDistance;
     currentLane     = nextLane;
     currentDistance = nextDistance;
     currentVelocity = nextVelocity;
@@ -129,9 +133,17 @@ public:
     nextVelocity = velocity;
   }
 
+  // Interface for relocating cars along their routes, see RoutingTable
+  unsigned int getRouteIndex() const { return routeIndex; }
+  void setRouteIndex(unsigned int index) { routeIndex = index; }
+
   // Interface for measuring the traveled distance per car for the traffic light optimization
   void updateTravelDistance(const double additionalDistance) { travelDistance += additionalDistance; }
   double getTravelDistance() const { return travelDistance; }
+
+  // Interface for writing only changed positions back to the domain model, see ModelSyncer
+  bool hasPositionChanged() const { return positionChanged; }
+  void setPositionChanged(bool changed) { positionChanged = changed; }
 };
 
 #endif
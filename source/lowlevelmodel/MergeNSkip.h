@@ -651,10 +651,11 @@ private:
       }
     }
 
-    // Set nextBehind index to the end index for all checkpoints where this is unset.
-    for (typename std::vector<Checkpoint>::iterator checkpointIt = checkpoints.begin() + checkpointIndex;
+    // Set nextBehind index to the last vehicle on each lane for all checkpoints behind which no vehicle is left. The
+    // checkpoint of the last vehicle has been set above already and must not be overwritten.
+    for (typename std::vector<Checkpoint>::iterator checkpointIt = checkpoints.begin() + checkpointIndex + 1;
          checkpointIt != checkpoints.end(); ++checkpointIt) {
-      for (unsigned int i = 0; i < MAX_LANES; ++i) { checkpointIt->lanes[i].nextBehind = endIt - beginIt; }
+      for (unsigned int i = 0; i < MAX_LANES; ++i) { checkpointIt->lanes[i].nextBehind = lastVehicleIts[i] - beginIt; }
     }
   }
 };
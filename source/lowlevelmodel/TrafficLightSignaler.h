@@ -426,7 +426,8 @@ public:
    * Meant to be used in copy constructors of embedding types.
    */
   TrafficLightSignaler(const TrafficLightSignaler &other, ConcreteRfbStructure &_rfb)
-      : rfb(_rfb), signal(other.signal), trafficLightCar(other.trafficLightCar) {}
+      : rfb(_rfb), signal(other.signal), trafficLightCar(other.trafficLightCar),
+        trafficLightPosition(other.trafficLightPosition) {}
 
   double getTrafficLightPosition() const { return trafficLightPosition; }
 
@@ -1,7 +1,26 @@
+#include <algorithm>
+#include <cstdlib>
 #include <exception>
+#include <fstream>
+#include <iomanip>
 #include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <vector>
+#ifdef OMP
+#include <omp.h>
+#endif
+
+#include <fcntl.h>
+#include <unistd.h>
 
+#include "AnnealingOptimizationRoutine.h"
+#include "BinaryScenarioReader.h"
+#include "BinaryScenarioWriter.h"
 #include "BucketList.h"
+#include "CheckpointFile.h"
 #include "CircularNaiveStreetDataStructure.h"
 #include "ConsistencyRoutine.h"
 #include "DomainModel.h"
@@ -17,34 +36,21 @@
 #include "ParallelConsistencyRoutine.h"
 #include "ParallelIDMRoutine.h"
 #include "ParallelTrafficLightRoutine.h"
+#include "Profiler.h"
 #include "RandomOptimizationRoutine.h"
+#include "RegionalOptimizationRoutine.h"
 #include "Simulator.h"
-#include "Timer.h"
 #include "TrafficLightRoutine.h"
-
-void printTimes() {
-  printTimerHeader();
-  printTimer(signalingRoutineTimer, "signalingRoutine");
-
-  printTimer(idmRoutineTimer, "idmRoutine");
-  printTimer(IDMRoutine_thresholdSorting_timer, "IDMRoutine_thresholdSorting");
-  printTimer(IDMRoutine_performStreetWise_timer, "IDMRoutine_performStreetWise");
-  printTimer(IDMRoutine_performCarWise_timer, "IDMRoutine_performCarWise");
-
-  printTimer(optimizationRoutineTimer, "optimizationRoutine");
-
-  printTimer(consistencyRoutineTimer, "consistencyRoutine");
-  printTimer(consistencyRoutine_restoreConsistency_timer, "consistencyRoutine_restoreConsistency");
-  printTimer(consistencyRoutine_relocateCars_timer, "consistencyRoutine_relocateCars");
-  printTimer(consistencyRoutine_incorporateCars_timer, "consistencyRoutine_incorporateCars");
-}
+#include "TrajectoryWriter.h"
 
 #ifdef AVX
 #include "Parallel_SIMD_IDMRoutine.h"
 #include "SIMD_IDMRoutine.h"
 #define IDM SIMD_IDMRoutine
+#define SEQUENTIAL_IDM SIMD_IDMRoutine
 #else
 #define IDM ParallelIDMRoutine
+#define SEQUENTIAL_IDM IDMRoutine
 #endif
 
 /**
@@ -53,48 +59,552 @@ void printTimes() {
  * The definitions are used by both Simulator and Optimizer.
  */
 
-#define RfbStructure NaiveStreetDataStructure
 using InitialTrafficLights = InitialTrafficLightsWithHeuristicSimulatorAndIteration<false>;
 
-int main_simulate(JSONReader &jsonReader, DomainModel &domainModel, JSONWriter &jsonWriter) {
-  Simulator<RfbStructure, ParallelTrafficLightRoutine, IDM, NullRoutine, ParallelConsistencyRoutine> simulator(
-      domainModel);
-  simulator.performSteps(jsonReader.getTimeSteps());
+/**
+ * The street data structures which can be selected at runtime. The bucket lists are not supported, their lane lookup
+ * in BucketList::findBucketIndex fails on the lane changes of a simulation.
+ */
+enum StreetStructure { NAIVE, CIRCULAR_NAIVE, MERGE_N_SKIP, MERGE_N_SKIP_CIRCULAR, AUTO_STRUCTURE };
+
+const char *const StreetStructureNames[] = {"naive", "circular-naive", "merge-n-skip", "merge-n-skip-circular", "auto"};
+
+/**
+ * The optimization routines which can be selected at runtime: random changes of the signal durations, durations from
+ * the green light requests of the cars, simulated annealing on the signal plans of the whole model and on the signal
+ * plans of regions of junctions, see RegionalDecomposition.
+ */
+enum OptimizationEngine { RANDOM, REQUEST, ANNEALING, REGIONAL };
+
+const char *const OptimizationEngineNames[] = {"random", "request", "annealing", "regional"};
+
+/**
+ * The Simulator and Optimizer types of a street data structure, either with the parallel routines or with their
+ * sequential counterparts.
+ */
+template <template <typename Vehicle> typename RfbStructure, bool parallel>
+struct Configuration {
+  using SimulatorType = std::conditional_t<parallel,
+      Simulator<RfbStructure, ParallelTrafficLightRoutine, IDM, NullRoutine, ParallelConsistencyRoutine>,
+      Simulator<RfbStructure, TrafficLightRoutine, SEQUENTIAL_IDM, NullRoutine, ConsistencyRoutine>>;
+
+  template <template <template <typename Vehicle> typename _RfbStructure> typename OptimizationRoutine>
+  using OptimizerWith = std::conditional_t<parallel,
+      Optimizer<RfbStructure, ParallelTrafficLightRoutine, ParallelIDMRoutine, OptimizationRoutine,
+          ParallelConsistencyRoutine, InitialTrafficLights>,
+      Optimizer<RfbStructure, TrafficLightRoutine, IDMRoutine, OptimizationRoutine, ConsistencyRoutine,
+          InitialTrafficLights>>;
+};
+
+template <template <typename Vehicle> typename RfbStructure, typename Run>
+int withRoutines(bool parallel, Run run) {
+  return parallel ? run(Configuration<RfbStructure, true>()) : run(Configuration<RfbStructure, false>());
+}
+
+/**
+ * Calls 'run' with the Configuration of the given street data structure and routines, all combinations are
+ * instantiated.
+ * @return     The result of 'run'.
+ */
+template <typename Run>
+int withConfiguration(StreetStructure structure, bool parallel, Run run) {
+  switch (structure) {
+  case CIRCULAR_NAIVE: return withRoutines<CircularNaiveStreetDataStructure>(parallel, run);
+  case MERGE_N_SKIP: return withRoutines<MergeNSkipLinear>(parallel, run);
+  case MERGE_N_SKIP_CIRCULAR: return withRoutines<MergeNSkipCircular>(parallel, run);
+  default: return withRoutines<NaiveStreetDataStructure>(parallel, run);
+  }
+}
+
+/**
+ * Chooses the street data structure for a domain model by the number of lanes and the density of the cars. Finding
+ * the cars on the adjacent lanes is faster with MergeNSkip, the naive structure is faster at updating the cars, see
+ * `make bench`. The lane changes only pay off on multi-lane streets which are not almost empty.
+ */
+StreetStructure chooseStreetStructure(const DomainModel &domainModel) {
+  double length     = 0; // km
+  double laneLength = 0; // km
+  for (const auto &street : domainModel.getStreets()) {
+    length += street.getLength() / 1000;
+    laneLength += street.getLanes() * street.getLength() / 1000;
+  }
+  if (length <= 0) return NAIVE;
 
-  jsonWriter.writeVehicles(domainModel);
+  const double averageLanes = laneLength / length;
+  const double density      = domainModel.getVehicles().size() / laneLength; // cars per lane and km
+  return averageLanes >= 2 && density >= 10 ? MERGE_N_SKIP : NAIVE;
+}
 
-#ifdef TIMER
-  printTimes();
+/**
+ * Number of candidate signal plans the optimizer evaluates concurrently, one per available thread.
+ */
+#ifdef OMP
+const unsigned OptimizationCandidates = omp_get_max_threads();
+#else
+const unsigned OptimizationCandidates = 1;
 #endif
+
+/**
+ * Default number of horizons the optimizer screens signal plans on by successive halving before simulating them
+ * completely. A single level disables the screening, short horizons did not rank signal plans reliably on our
+ * scenarios.
+ */
+const unsigned OptimizationFidelityLevels = 1;
+
+/**
+ * Command line options, see main.
+ */
+struct Options {
+  std::vector<const char *> scenarioPaths;
+  bool convert                = false;
+  bool binaryOutput           = false;
+  const char *trajectoryPath  = nullptr;
+  unsigned trajectoryInterval = 1;
+  const char *checkpointPath  = nullptr;
+  unsigned checkpointInterval = 0;
+  const char *resumePath      = nullptr;
+  const char *profilePath     = nullptr;
+  bool profileStreets         = false;
+  unsigned counterWindow      = 0;
+  std::vector<unsigned> benchThreadCounts;
+  bool weakScaling                = false;
+  StreetStructure streetStructure = NAIVE;
+  bool parallelRoutines           = true;
+  unsigned fidelityLevels         = OptimizationFidelityLevels;
+  OptimizationEngine optimization = RANDOM;
+
+  /**
+   * The street data structure for the domain model, resolves the automatic choice.
+   */
+  StreetStructure getStreetStructure(const DomainModel &domainModel) const {
+    return streetStructure == AUTO_STRUCTURE ? chooseStreetStructure(domainModel) : streetStructure;
+  }
+};
+
+/**
+ * Runs the simulation with the trajectory and checkpoint options: resumes from a checkpoint, records the trajectory
+ * and writes checkpoints during the simulation.
+ */
+template <typename Simulator>
+int simulateWithCheckpoints(
+    Simulator &simulator, unsigned timeSteps, DomainModel &domainModel, const Options &options) {
+  unsigned performedSteps = 0;
+  if (options.resumePath != nullptr) {
+    std::ifstream checkpoint(options.resumePath, std::ios::binary);
+    if (!checkpoint) {
+      std::cerr << "Cannot open checkpoint " << options.resumePath << "." << std::endl;
+      return 1;
+    }
+    performedSteps = simulator.restoreCheckpoint(checkpoint);
+    if (performedSteps > timeSteps) {
+      std::cerr << "The checkpoint is beyond the time steps of the scenario." << std::endl;
+      return 1;
+    }
+  }
+
+  std::ofstream trajectoryFile;
+  std::unique_ptr<TrajectoryWriter> trajectoryWriter;
+  if (options.trajectoryPath != nullptr) {
+    trajectoryFile.open(options.trajectoryPath, std::ios::binary);
+    if (!trajectoryFile) {
+      std::cerr << "Cannot open trajectory file " << options.trajectoryPath << "." << std::endl;
+      return 1;
+    }
+    trajectoryWriter.reset(
+        new TrajectoryWriter(trajectoryFile, domainModel.getVehicles().size(), options.trajectoryInterval));
+    simulator.recordTrajectoryFrame(*trajectoryWriter, performedSteps);
+  }
+
+  std::unique_ptr<CheckpointFile> checkpointFile;
+  if (options.checkpointPath != nullptr) {
+    checkpointFile.reset(new CheckpointFile(options.checkpointPath, options.checkpointInterval));
+  }
+
+  simulator.performStepsUntil(timeSteps - performedSteps, [&](unsigned steps) {
+    const unsigned step = performedSteps + steps;
+    if (trajectoryWriter && (step % trajectoryWriter->getInterval() == 0 || step == timeSteps))
+      simulator.recordTrajectoryFrame(*trajectoryWriter, step);
+    if (checkpointFile && step % checkpointFile->getInterval() == 0 && step < timeSteps)
+      simulator.writeCheckpoint(*checkpointFile, step);
+    return false;
+  });
+
+  if (trajectoryWriter) trajectoryWriter->finish();
+  if (checkpointFile) checkpointFile->finish();
   return 0;
 }
 
-int main_optimize(JSONReader &jsonReader, DomainModel &domainModel, JSONWriter &jsonWriter) {
-  Optimizer<NaiveStreetDataStructure, ParallelTrafficLightRoutine, ParallelIDMRoutine, RandomOptimizationRoutine,
-      ParallelConsistencyRoutine, InitialTrafficLights>
-      optimizer(domainModel, jsonReader.getTimeSteps(), jsonReader.getMinTravelDistance());
+template <typename SelectedConfiguration, typename Reader>
+int main_simulate(Reader &reader, DomainModel &domainModel, JSONWriter &jsonWriter, const Options &options) {
+  typename SelectedConfiguration::SimulatorType simulator(domainModel);
+  if (options.trajectoryPath == nullptr && options.checkpointPath == nullptr && options.resumePath == nullptr) {
+    simulator.performSteps(reader.getTimeSteps());
+  } else if (simulateWithCheckpoints(simulator, reader.getTimeSteps(), domainModel, options) != 0) {
+    return 1;
+  }
+
+  if (options.binaryOutput) {
+    BinaryScenarioWriter binaryWriter(std::cout);
+    binaryWriter.writeVehicles(domainModel);
+  } else {
+    jsonWriter.writeVehicles(domainModel);
+  }
+  return 0;
+}
+
+template <typename OptimizerType, typename Reader>
+int runOptimizer(Reader &reader, DomainModel &domainModel, JSONWriter &jsonWriter, const Options &options) {
+  OptimizerType optimizer(domainModel, reader.getTimeSteps(), reader.getMinTravelDistance(), -1,
+      OptimizationCandidates, options.fidelityLevels);
   optimizer.optimizeTrafficLights();
   jsonWriter.writeSignals(domainModel);
-#ifdef TIMER
-  printTimes();
-#endif
+  if (Profiler::getLevel() != Profiler::OFF) optimizer.printSimulationEffort();
   return 0;
 }
 
-int main() {
-  DomainModel domainModel;
+template <typename SelectedConfiguration, typename Reader>
+int main_optimize(Reader &reader, DomainModel &domainModel, JSONWriter &jsonWriter, const Options &options) {
+  switch (options.optimization) {
+  case ANNEALING:
+    return runOptimizer<typename SelectedConfiguration::template OptimizerWith<AnnealingOptimizationRoutine>>(
+        reader, domainModel, jsonWriter, options);
+  case REQUEST:
+    return runOptimizer<typename SelectedConfiguration::template OptimizerWith<OptimizationRoutine>>(
+        reader, domainModel, jsonWriter, options);
+  case REGIONAL:
+    return runOptimizer<typename SelectedConfiguration::template OptimizerWith<RegionalOptimizationRoutine>>(
+        reader, domainModel, jsonWriter, options);
+  default:
+    return runOptimizer<typename SelectedConfiguration::template OptimizerWith<RandomOptimizationRoutine>>(
+        reader, domainModel, jsonWriter, options);
+  }
+}
 
-  JSONReader jsonReader(std::cin);
-  JSONWriter jsonWriter(std::cout);
+/**
+ * Reads the scenario and either runs it or, with --convert, writes it in the binary scenario format.
+ */
+template <typename Reader>
+int main_run(Reader &reader, const Options &options) {
+  DomainModel domainModel;
+  reader.readInto(domainModel);
 
-  jsonReader.readInto(domainModel);
+  if (options.convert) {
+    BinaryScenarioWriter binaryWriter(std::cout);
+    binaryWriter.writeScenario(domainModel, reader.getMode(), reader.getTimeSteps(), reader.getMinTravelDistance());
+    return 0;
+  }
 
-  switch (jsonReader.getMode()) {
-  case JSONReader::SIMULATE: return main_simulate(jsonReader, domainModel, jsonWriter);
-  case JSONReader::OPTIMIZE: return main_optimize(jsonReader, domainModel, jsonWriter);
+  JSONWriter jsonWriter(std::cout);
+  const StreetStructure structure = options.getStreetStructure(domainModel);
+  switch (reader.getMode()) {
+  case JSONReader::SIMULATE:
+    return withConfiguration(structure, options.parallelRoutines, [&](auto configuration) {
+      return main_simulate<decltype(configuration)>(reader, domainModel, jsonWriter, options);
+    });
+  case JSONReader::OPTIMIZE:
+    return withConfiguration(structure, options.parallelRoutines, [&](auto configuration) {
+      return main_optimize<decltype(configuration)>(reader, domainModel, jsonWriter, options);
+    });
   default: {
     std::cerr << "Unknown execution mode." << std::endl;
     return 1;
   }
   }
 }
+
+/**
+ * Parses a comma separated list of thread counts, returns false if it is invalid.
+ */
+bool parseThreadCounts(const char *list, std::vector<unsigned> &threadCounts) {
+  std::istringstream in(list);
+  std::string threadCount;
+  while (std::getline(in, threadCount, ',')) {
+    const int threads = std::atoi(threadCount.c_str());
+    if (threads <= 0) return false;
+    threadCounts.push_back(threads);
+  }
+  return !threadCounts.empty();
+}
+
+/**
+ * Parses the command line, returns false if it is invalid.
+ */
+bool parseOptions(int argc, char *argv[], Options &options) {
+  for (int i = 1; i < argc; ++i) {
+    const std::string argument(argv[i]);
+    if (argument == "--convert") {
+      options.convert = true;
+    } else if (argument == "--binary-output") {
+      options.binaryOutput = true;
+    } else if (argument == "--trajectory" && i + 1 < argc) {
+      options.trajectoryPath = argv[++i];
+    } else if (argument == "--trajectory-interval" && i + 1 < argc) {
+      const int interval = std::atoi(argv[++i]);
+      if (interval <= 0) return false;
+      options.trajectoryInterval = interval;
+    } else if (argument == "--checkpoint" && i + 2 < argc) {
+      options.checkpointPath = argv[++i];
+      const int interval     = std::atoi(argv[++i]);
+      if (interval <= 0) return false;
+      options.checkpointInterval = interval;
+    } else if (argument == "--resume" && i + 1 < argc) {
+      options.resumePath = argv[++i];
+    } else if (argument == "--profile" && i + 1 < argc) {
+      options.profilePath = argv[++i];
+    } else if (argument == "--profile-streets") {
+      options.profileStreets = true;
+    } else if (argument == "--perf-counters" && i + 1 < argc) {
+      const int window = std::atoi(argv[++i]);
+      if (window <= 0) return false;
+      options.counterWindow = window;
+    } else if (argument == "--bench" && i + 1 < argc) {
+      if (!parseThreadCounts(argv[++i], options.benchThreadCounts)) return false;
+    } else if (argument == "--weak-scaling") {
+      options.weakScaling = true;
+    } else if (argument == "--structure" && i + 1 < argc) {
+      const std::string name(argv[++i]);
+      const auto structure = std::find(std::begin(StreetStructureNames), std::end(StreetStructureNames), name);
+      if (structure == std::end(StreetStructureNames)) return false;
+      options.streetStructure = StreetStructure(structure - std::begin(StreetStructureNames));
+    } else if (argument == "--routines" && i + 1 < argc) {
+      const std::string routines(argv[++i]);
+      if (routines != "parallel" && routines != "sequential") return false;
+      options.parallelRoutines = routines == "parallel";
+    } else if (argument == "--fidelity-levels" && i + 1 < argc) {
+      const int levels = std::atoi(argv[++i]);
+      if (levels <= 0 || !isValidFidelityLevelCount(OptimizationCandidates, levels)) return false;
+      options.fidelityLevels = levels;
+    } else if (argument == "--optimization" && i + 1 < argc) {
+      const std::string name(argv[++i]);
+      const auto engine = std::find(std::begin(OptimizationEngineNames), std::end(OptimizationEngineNames), name);
+      if (engine == std::end(OptimizationEngineNames)) return false;
+      options.optimization = OptimizationEngine(engine - std::begin(OptimizationEngineNames));
+    } else if (argument.compare(0, 2, "--") != 0) {
+      options.scenarioPaths.push_back(argv[i]);
+    } else {
+      return false;
+    }
+  }
+
+  if (options.profilePath == nullptr && (options.profileStreets || options.counterWindow > 0)) return false;
+  if (options.benchThreadCounts.empty()) return options.scenarioPaths.size() <= 1 && !options.weakScaling;
+  // weak scaling pairs each scenario with a thread count
+  return !options.weakScaling || options.scenarioPaths.size() == options.benchThreadCounts.size();
+}
+
+/**
+ * Writes the zones recorded by the profiler to the trace file and prints their summary to stderr.
+ */
+int writeProfile(const Options &options) {
+  std::ofstream trace(options.profilePath);
+  if (!trace) {
+    std::cerr << "Cannot open profile " << options.profilePath << "." << std::endl;
+    return 1;
+  }
+  Profiler::writeChromeTrace(trace);
+  Profiler::printSummary(std::cerr);
+  return 0;
+}
+
+/**
+ * Closes the descriptor of a scenario file on all paths, also if reading the scenario throws.
+ */
+struct ScenarioDescriptor {
+  int fd = -1;
+
+  ScenarioDescriptor() = default;
+  ScenarioDescriptor(const ScenarioDescriptor &other) = delete;
+  ScenarioDescriptor &operator=(const ScenarioDescriptor &other) = delete;
+  ~ScenarioDescriptor() { release(); }
+
+  void release() {
+    if (fd >= 0) close(fd);
+    fd = -1;
+  }
+};
+
+/**
+ * Opens the scenario at the path, or stdin if the path is null, and calls 'run' with a reader for its format.
+ * @return     The result of 'run', or 1 if the scenario cannot be opened.
+ */
+template <typename Run>
+int readScenario(const char *path, Run run) {
+  std::ifstream file;
+  ScenarioDescriptor descriptor;
+  int fd = STDIN_FILENO;
+  if (path != nullptr) {
+    file.open(path, std::ios::binary);
+    descriptor.fd = fd = open(path, O_RDONLY);
+    if (!file || fd < 0) {
+      std::cerr << "Cannot open scenario " << path << "." << std::endl;
+      return 1;
+    }
+  }
+  std::istream &in = path != nullptr ? file : std::cin;
+
+  // regular files are mapped, other inputs are only read through the stream
+  const bool mappable = BinaryScenarioReader::isMappable(fd);
+  if (mappable ? BinaryScenarioReader::isBinaryScenario(fd) : BinaryScenarioReader::isBinaryScenario(in)) {
+    BinaryScenarioReader binaryReader = mappable ? BinaryScenarioReader(fd) : BinaryScenarioReader(in);
+    descriptor.release();
+    return run(binaryReader);
+  }
+
+  descriptor.release();
+  JSONReader jsonReader(in);
+  return run(jsonReader);
+}
+
+/**
+ * Simulates each scenario with each of the thread counts, or with weak scaling the i-th scenario with the i-th thread
+ * count, and writes the results as CSV to stdout: the throughput in steps and in cars times steps per second, the
+ * speedup and the parallel efficiency, and the time per step spent in each phase. Only the steps are measured, reading
+ * the scenario and building the low level model are not. With --profile, the profile of the last run is written.
+ *
+ * The speedup is relative to the first thread count of the same scenario, with weak scaling it is the throughput in
+ * cars times steps relative to the first scenario. The efficiency is the speedup divided by the relative increase in
+ * threads.
+ */
+int main_bench(const Options &options) {
+#ifndef OMP
+  for (unsigned threads : options.benchThreadCounts) {
+    if (threads != 1) {
+      std::cerr << "Benchmarking multiple threads requires the OpenMP build." << std::endl;
+      return 1;
+    }
+  }
+#endif
+  // the phases are timed by the profiler, which is only enabled by --profile otherwise
+  if (Profiler::getLevel() == Profiler::OFF) Profiler::enable(Profiler::PHASES);
+
+  std::vector<const char *> paths = options.scenarioPaths;
+  if (paths.empty()) paths.push_back(nullptr);
+
+  bool headerWritten        = false;
+  double baselineThroughput = 0; // cars times steps per second
+  unsigned baselineThreads  = 0;
+  std::cout << std::fixed << std::setprecision(3);
+  for (std::size_t scenario = 0; scenario < paths.size(); ++scenario) {
+    DomainModel scenarioModel;
+    unsigned timeSteps = 0;
+    const int result   = readScenario(paths[scenario], [&](auto &reader) {
+      reader.readInto(scenarioModel);
+      timeSteps = reader.getTimeSteps();
+      return 0;
+    });
+    if (result != 0) return result;
+
+    std::vector<unsigned> threadCounts = options.benchThreadCounts;
+    if (options.weakScaling) threadCounts = {options.benchThreadCounts[scenario]};
+    for (std::size_t run = 0; run < threadCounts.size(); ++run) {
+#ifdef OMP
+      omp_set_num_threads(threadCounts[run]);
+#endif
+      DomainModel domainModel(scenarioModel);
+      const StreetStructure structure = options.getStreetStructure(domainModel);
+      Profiler::clear();
+      withConfiguration(structure, options.parallelRoutines, [&](auto configuration) {
+        typename decltype(configuration)::SimulatorType simulator(domainModel);
+        simulator.performSteps(timeSteps);
+        return 0;
+      });
+
+      std::vector<Profiler::ZoneSummary> zones = Profiler::summarize();
+      const auto stepZone =
+          std::find_if(zones.begin(), zones.end(), [](const auto &zone) { return zone.name == "step"; });
+      const double seconds    = stepZone != zones.end() ? stepZone->totalTime / 1e6 : 0;
+      const double cars       = domainModel.getVehicles().size();
+      const double throughput = seconds > 0 ? cars * timeSteps / seconds : 0;
+      if (run == 0 && (scenario == 0 || !options.weakScaling)) {
+        baselineThroughput = throughput;
+        baselineThreads    = threadCounts[run];
+      }
+      const double speedup    = baselineThroughput > 0 ? throughput / baselineThroughput : 0;
+      const double efficiency = speedup * baselineThreads / threadCounts[run];
+
+      if (!headerWritten) {
+        std::cout << "scenario,structure,routines,threads,cars,steps,seconds,steps_per_second,car_steps_per_second,"
+                     "speedup,efficiency";
+        for (const auto &zone : zones) {
+          if (zone.depth > 0) std::cout << "," << zone.name << "_us_per_step";
+        }
+        std::cout << "\n";
+        headerWritten = true;
+      }
+      std::cout << (paths[scenario] != nullptr ? paths[scenario] : "-") << "," << StreetStructureNames[structure] << ","
+                << (options.parallelRoutines ? "parallel" : "sequential") << "," << threadCounts[run] << ","
+                << domainModel.getVehicles().size() << "," << timeSteps << "," << seconds << ","
+                << (seconds > 0 ? timeSteps / seconds : 0) << "," << throughput << "," << speedup << ","
+                << efficiency;
+      for (const auto &zone : zones) {
+        if (zone.depth > 0) std::cout << "," << (timeSteps > 0 ? zone.totalTime / timeSteps : 0);
+      }
+      std::cout << std::endl;
+    }
+  }
+  return 0;
+}
+
+/**
+ * Usage: traffic_sim [--convert] [--binary-output] [--trajectory file [--trajectory-interval n]]
+ *                    [--checkpoint file n] [--resume file] [--profile file [--profile-streets] [--perf-counters n]]
+ *                    [--structure name] [--routines parallel|sequential] [--fidelity-levels n]
+ *                    [--optimization name] [scenario]
+ *        traffic_sim --bench threads [--weak-scaling] [--structure name] [--routines ...] [--profile file ...]
+ *                    [scenario...]
+ *
+ * The scenario is read from the given file or from stdin, either as JSON or in the binary scenario format, which is
+ * detected automatically.
+ *
+ * --convert                 Write the scenario to stdout in the binary format instead of running it.
+ * --binary-output           Write the vehicle positions after a simulation in the binary format instead of JSON.
+ * --trajectory file         Write the vehicle positions every n steps of a simulation to the file.
+ * --trajectory-interval n   The number of steps between two recorded positions, 1 by default.
+ * --checkpoint file n       Write the state of a simulation to the file every n steps, see CheckpointFile.
+ * --resume file             Continue a simulation from a checkpoint of the same scenario.
+ * --profile file            Record the time spent in each phase of the steps, write it to the file in the Chrome trace
+ *                           event format and print a summary to stderr, see Profiler.
+ * --profile-streets         Additionally record the time spent on each street.
+ * --perf-counters n         Count cycles, instructions, last level cache misses and branch misses in each phase and
+ *                           print the counts of every n steps to stderr, requires perf_event_open.
+ * --bench threads           Simulate each scenario with each of the comma separated thread counts and write the
+ *                           throughput and the time per phase as CSV to stdout, see main_bench.
+ * --weak-scaling            Simulate the i-th scenario with the i-th thread count instead, e.g. scenarios generated
+ *                           from tools/generator_configs/sparseScaling.
+ * --structure name          The street data structure: naive (default), circular-naive, merge-n-skip,
+ *                           merge-n-skip-circular or auto, which chooses by the lanes and the density of the cars.
+ * --routines name           The parallel routines (default) or their sequential counterparts.
+ * --fidelity-levels n       Screen the signal plans of an optimization on n horizons by successive halving, 1 by
+ *                           default: 2^(n-1) plans per candidate are simulated for 2^(1-n) of the time steps, the
+ *                           better half is promoted to a twice as long horizon until the rest is simulated completely.
+ * --optimization name       The optimization routine: random changes of the signal durations (random, default),
+ *                           durations from the green light requests of the cars (request), simulated annealing on the
+ *                           signal plans of the whole model (annealing) or of regions of junctions, which are validated
+ *                           on the whole model (regional).
+ */
+int main(int argc, char *argv[]) {
+  Options options;
+  if (!parseOptions(argc, argv, options)) {
+    std::cerr << "Usage: " << argv[0]
+              << " [--convert] [--binary-output] [--trajectory file [--trajectory-interval n]]"
+                 " [--checkpoint file n] [--resume file] [--profile file [--profile-streets] [--perf-counters n]]"
+                 " [--structure name] [--routines parallel|sequential] [--fidelity-levels n]"
+                 " [--optimization random|request|annealing|regional] [scenario]\n       "
+              << argv[0]
+              << " --bench threads [--weak-scaling] [--structure name] [--routines ...] [--profile file ...]"
+                 " [scenario...]"
+              << std::endl;
+    return 1;
+  }
+  if (options.profilePath != nullptr) Profiler::enable(options.profileStreets ? Profiler::STREETS : Profiler::PHASES);
+  std::string counterError;
+  if (options.counterWindow > 0 && !Profiler::enableCounters(options.counterWindow, std::cerr, counterError)) {
+    std::cerr << "Performance counters are not available: " << counterError << "." << std::endl;
+  }
+
+  const int result = !options.benchThreadCounts.empty()
+                         ? main_bench(options)
+                         : readScenario(options.scenarioPaths.empty() ? nullptr : options.scenarioPaths[0],
+                               [&](auto &reader) { return main_run(reader, options); });
+  return options.profilePath != nullptr && result == 0 ? writeProfile(options) : result;
+}
@@ -0,0 +1,161 @@
+#ifndef ANNEALING_SIGNAL_PLAN_SEARCH_H
+#define ANNEALING_SIGNAL_PLAN_SEARCH_H
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "DomainModel.h"
+#include "Junction.h"
+
+/**
+ * Gradient-free search over the signal plans of all junctions based on simulated annealing.
+ *
+ * A signal plan contains the signals of each junction (indexed by junction id), i.e. the durations of all junctions
+ * form a single search vector. In each generation the search proposes a population of plans, each one derived from the
+ * current plan by perturbing the signal durations and swapping the signal order of some randomly chosen junctions.
+ * The caller evaluates the population (e.g. concurrently with the simulator) and reports the fitness of each plan,
+ * higher is better. The best plan of the population replaces the current plan if it is better or, with a probability
+ * decreasing with the temperature, if it is only slightly worse.
+ *
+ * The perturbation step size adapts to the success rate: it grows after improvements and shrinks otherwise.
+ */
+class AnnealingSignalPlanSearch {
+public:
+  using SignalPlan = std::vector<std::vector<Junction::Signal>>;
+
+protected:
+  // probability of each junction to be changed in a proposal, at least one junction is changed
+  const double junctionMutationProbability = 0.2;
+  // probability of swapping two signals of a changed junction
+  const double orderMutationProbability = 0.2;
+  // relative fitness loss accepted with probability 1/e, decreases with each generation by the cooling factor
+  double temperature         = 0.01;
+  const double coolingFactor = 0.9;
+  // standard deviation of the duration perturbation in seconds
+  double stepSize             = 3;
+  const double minStepSize    = 1;
+  const double maxStepSize    = 10;
+  const double stepSizeGrowth = 1.2;
+  const double stepSizeDecay  = 0.95;
+
+  SignalPlan currentPlan;
+  double currentFitness     = -std::numeric_limits<double>::infinity();
+  bool currentPlanEvaluated = false;
+
+  SignalPlan bestPlan;
+  double bestFitness = -std::numeric_limits<double>::infinity();
+
+  std::vector<std::size_t> allJunctionIds;
+
+  std::mt19937 rng;
+
+  /** Perturbs the durations and possibly the order of the signals of a single junction. */
+  void mutateJunction(std::vector<Junction::Signal> &signals) {
+    std::normal_distribution<double> durationChange(0, stepSize);
+    for (auto &signal : signals) {
+      double duration = std::round(signal.getDuration() + durationChange(rng));
+      signal          = Junction::Signal(signal.getDirection(), static_cast<unsigned>(std::max(5.0, duration)));
+    }
+    if (signals.size() > 1 && std::bernoulli_distribution(orderMutationProbability)(rng)) {
+      std::uniform_int_distribution<std::size_t> signalIndex(0, signals.size() - 1);
+      std::swap(signals[signalIndex(rng)], signals[signalIndex(rng)]);
+    }
+  }
+
+  /**
+   * Derives a new signal plan from the current one by changing each of the given junctions with the given probability,
+   * but at least one. Junctions with a single signal are left unchanged.
+   */
+  SignalPlan proposeSignalPlan(const std::vector<std::size_t> &junctionIds, const double mutationProbability) {
+    SignalPlan plan = currentPlan;
+    std::vector<std::size_t> mutableJunctions;
+    for (std::size_t i : junctionIds) {
+      if (plan[i].size() > 1) { mutableJunctions.push_back(i); }
+    }
+    if (mutableJunctions.empty()) { return plan; }
+
+    std::bernoulli_distribution isMutated(mutationProbability);
+    bool mutated = false;
+    for (std::size_t i : mutableJunctions) {
+      if (isMutated(rng)) {
+        mutateJunction(plan[i]);
+        mutated = true;
+      }
+    }
+    if (!mutated) {
+      std::uniform_int_distribution<std::size_t> junctionIndex(0, mutableJunctions.size() - 1);
+      mutateJunction(plan[mutableJunctions[junctionIndex(rng)]]);
+    }
+    return plan;
+  }
+
+  /** Returns the signals of all junctions of the given domain model. */
+  static SignalPlan getSignalPlan(const DomainModel &model) {
+    SignalPlan signalPlan;
+    signalPlan.reserve(model.getJunctions().size());
+    for (const auto &junction : model.getJunctions()) { signalPlan.push_back(junction.getSignals()); }
+    return signalPlan;
+  }
+
+public:
+  /** Starts the search from the signals currently set in the junctions of the given domain model. */
+  AnnealingSignalPlanSearch(const DomainModel &model, const unsigned seed = std::random_device()())
+      : currentPlan(getSignalPlan(model)), bestPlan(currentPlan), allJunctionIds(currentPlan.size()), rng(seed) {
+    for (std::size_t i = 0; i < allJunctionIds.size(); ++i) { allJunctionIds[i] = i; }
+  }
+
+  /** Derives a new signal plan from the current one by changing some of the junctions. */
+  SignalPlan proposeNeighbour() { return proposeSignalPlan(allJunctionIds, junctionMutationProbability); }
+
+  /**
+   * Proposes 'populationSize' signal plans to be evaluated. As long as the current plan has not been evaluated, it is
+   * part of the population.
+   */
+  std::vector<SignalPlan> proposePopulation(const unsigned populationSize) {
+    std::vector<SignalPlan> population;
+    population.reserve(populationSize);
+    if (!currentPlanEvaluated && populationSize > 0) { population.push_back(currentPlan); }
+    while (population.size() < populationSize) {
+      population.push_back(proposeSignalPlan(allJunctionIds, junctionMutationProbability));
+    }
+    return population;
+  }
+
+  /**
+   * Reports the fitness of the previously proposed population and advances the search to the next generation.
+   * @param[in]  population  The evaluated signal plans
+   * @param[in]  fitness     The fitness of each plan in the population, higher is better
+   */
+  void reportFitness(const std::vector<SignalPlan> &population, const std::vector<double> &fitness) {
+    if (population.empty()) { return; }
+    const std::size_t fittest = std::max_element(fitness.begin(), fitness.end()) - fitness.begin();
+    if (fitness[fittest] > bestFitness) {
+      bestFitness = fitness[fittest];
+      bestPlan    = population[fittest];
+    }
+
+    const bool improved = fitness[fittest] > currentFitness;
+    bool accepted       = improved;
+    if (!improved) { // metropolis criterion on the relative fitness loss
+      double relativeLoss = (currentFitness - fitness[fittest]) / std::max(std::abs(currentFitness), 1.0);
+      accepted            = std::uniform_real_distribution<double>(0, 1)(rng) < std::exp(-relativeLoss / temperature);
+    }
+    if (accepted) {
+      currentPlan    = population[fittest];
+      currentFitness = fitness[fittest];
+    }
+    currentPlanEvaluated = true;
+
+    stepSize = std::min(maxStepSize, std::max(minStepSize, stepSize * (improved ? stepSizeGrowth : stepSizeDecay)));
+    temperature *= coolingFactor;
+  }
+
+  const SignalPlan &getBestPlan() const { return bestPlan; }
+  double getBestFitness() const { return bestFitness; }
+};
+
+#endif
@@ -1,6 +1,16 @@
 #ifndef HEURISTIC_SIMULATOR_H
 #define HEURISTIC_SIMULATOR_H
 
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <unordered_set>
+#include <vector>
+#ifdef OMP
+#include <omp.h>
+#endif
+
 #include "DomainModel.h"
 #include "ModelSyncer.h"
 #include "TrafficLightCrossingUtils.h"
@@ -14,80 +24,179 @@ class HeuristicSimulator {
   // distance reachable in an accurate simulation. This distance is also used as a cars priority.
   std::vector<double> optimalTravelDistancePerCar;
 
-  // Counts for each street and each car how often the car passed through the traffic light at the end of the street.
-  // The two directions of a street are considered separately.
-  std::vector<std::vector<unsigned>> trafficLightCrossingCountPerCarPerStreet;
-  // Tracks which car drives when through the traffic light at the end of a specific street.
-  std::vector<std::vector<TrafficLightCrossing>> trafficLightCrossingsPerStreet;
+  // Sums for each street the priority of all cars passing through the traffic light at the end of the street, a car
+  // passing multiple times is counted multiple times. The two directions of a street are considered separately.
+  std::vector<double> prioritizedThroughputPerStreet;
+  // Tracks which car drives when through the traffic light at the end of a specific street. The crossings of all
+  // streets are stored consecutively ordered by street, the crossings of a street start at the offset of the street.
+  std::vector<TrafficLightCrossing> trafficLightCrossings;
+  std::vector<std::size_t> trafficLightCrossingOffsetPerStreet;
+
+  // The street taken at the target junction of a street, per street and turn direction. NO_NEXT_STREET if the target
+  // junction has no connected outgoing street.
+  std::vector<std::array<unsigned, 4>> nextStreet;
+  static constexpr unsigned NO_NEXT_STREET = std::numeric_limits<unsigned>::max();
 
 public:
   HeuristicSimulator(const DomainModel &domainModel)
       : domainModel(domainModel), carCount(domainModel.getVehicles().size()),
         streetCount(domainModel.getStreets().size()), optimalTravelDistancePerCar(carCount, 0),
-        trafficLightCrossingCountPerCarPerStreet(carCount, std::vector<unsigned>(streetCount, 0)),
-        trafficLightCrossingsPerStreet(streetCount, std::vector<TrafficLightCrossing>()) {}
+        prioritizedThroughputPerStreet(streetCount, 0), trafficLightCrossingOffsetPerStreet(streetCount + 1, 0),
+        nextStreet(streetCount, {{NO_NEXT_STREET, NO_NEXT_STREET, NO_NEXT_STREET, NO_NEXT_STREET}}) {
+    determineNextStreets();
+  }
 
   // Simulated 'stepCount' steps heuristically for each car while ignoring traffic lights and other cars.
-  // Store the distance traveled per car and which traffic lights it passed how often.
+  // Store the distance traveled per car and which traffic lights it passed how often. Replaces previous results.
+  // Cars are simulated in parallel, each thread collects its traffic light crossings in a separate buffer. The buffers
+  // are merged in thread order afterwards, i.e. the crossings per street remain ordered by car id.
   void performSteps(const unsigned stepCount) {
-    for (unsigned carId = 0; carId < carCount; ++carId) { // for each car
-      const Vehicle &car = domainModel.getVehicle(carId);
+    reset();
+
+    std::vector<std::vector<TrafficLightCrossing>> crossingsPerThread;
+#pragma omp parallel shared(crossingsPerThread)
+    {
+#ifdef OMP
+#pragma omp single
+      crossingsPerThread.resize(omp_get_num_threads());
+      std::vector<TrafficLightCrossing> &crossings = crossingsPerThread[omp_get_thread_num()];
+#else
+      crossingsPerThread.resize(1);
+      std::vector<TrafficLightCrossing> &crossings = crossingsPerThread[0];
+#endif
+#pragma omp for schedule(static)
+      for (unsigned carId = 0; carId < carCount; ++carId) { performSteps(carId, stepCount, crossings); }
+    }
 
-      Street *currentStreet        = car.getPosition().getStreet();
-      double currentDistance       = car.getPosition().getDistance();
-      double currentTravelDistance = 0;
-      unsigned turnDirectionIndex  = 0;
-      const auto &route            = car.getRoute();
+    mergeTrafficLightCrossings(crossingsPerThread);
+  }
 
-      for (unsigned timeStep = 0; timeStep < stepCount; ++timeStep) { // estimate all time steps
-        double velocity             = std::min(car.getTargetVelocity(), currentStreet->getSpeedLimit());
-        double trafficLightPosition = currentStreet->getLength() - TRAFFIC_LIGHT_OFFSET;
-        bool didCrossTrafficLight   = (currentDistance < trafficLightPosition);
+private:
+  // Returns the number of steps a car at 'distance' driving with 'velocity' needs to reach 'targetDistance', at
+  // least 1.
+  static unsigned stepsToReach(const double distance, const double velocity, const double targetDistance) {
+    double steps = std::max(1.0, std::ceil((targetDistance - distance) / velocity));
+    // correct rounding errors such that the result matches a step-wise simulation
+    while (steps > 1 && distance + (steps - 1) * velocity >= targetDistance) { --steps; }
+    while (distance + steps * velocity < targetDistance) { ++steps; }
+    return std::min<double>(steps, std::numeric_limits<unsigned>::max());
+  }
 
-        currentTravelDistance += velocity;
-        currentDistance += velocity;
+  // Simulates 'stepCount' steps for a single car and appends its traffic light crossings to 'crossings'.
+  // As the velocity of a car is constant on a street, the simulation jumps from street to street instead of simulating
+  // each step separately.
+  void performSteps(const unsigned carId, const unsigned stepCount, std::vector<TrafficLightCrossing> &crossings) {
+    const Vehicle &car = domainModel.getVehicles()[carId];
+    const auto &route  = car.getRoute();
+
+    unsigned currentStreetId     = car.getPosition().getStreet()->getId();
+    double currentDistance       = car.getPosition().getDistance();
+    double currentTravelDistance = 0;
+    unsigned turnDirectionIndex  = 0;
+    unsigned timeStep            = 0;
+
+    while (timeStep < stepCount) {
+      const Street &currentStreet = domainModel.getStreets()[currentStreetId];
+      const double velocity       = std::min(car.getTargetVelocity(), currentStreet.getSpeedLimit());
+      if (velocity <= 0) { break; } // the car does not move at all
+
+      // record the traffic light crossing if the car reaches the traffic light in time
+      double trafficLightPosition = currentStreet.getLength() - TRAFFIC_LIGHT_OFFSET;
+      if (currentDistance < trafficLightPosition) {
+        unsigned stepsToTrafficLight = stepsToReach(currentDistance, velocity, trafficLightPosition);
+        if (stepsToTrafficLight <= stepCount - timeStep) {
+          crossings.push_back(TrafficLightCrossing(carId, currentStreetId, timeStep + stepsToTrafficLight - 1));
+        }
+      }
 
-        didCrossTrafficLight = didCrossTrafficLight && (currentDistance >= trafficLightPosition);
+      // stop at the last step if the car does not leave the current street in time
+      unsigned stepsToStreetEnd = stepsToReach(currentDistance, velocity, currentStreet.getLength());
+      if (stepsToStreetEnd > stepCount - timeStep) {
+        currentTravelDistance += (stepCount - timeStep) * velocity;
+        break;
+      }
 
-        if (didCrossTrafficLight) {
-          ++trafficLightCrossingCountPerCarPerStreet[carId][currentStreet->getId()]; // increment throughput
-          trafficLightCrossingsPerStreet[currentStreet->getId()].push_back(
-              TrafficLightCrossing(carId, currentStreet->getId(), timeStep));
-        }
+      // stop at the end of the current street if there is no street to continue on
+      const unsigned nextStreetId = nextStreet[currentStreetId][route[turnDirectionIndex]];
+      if (nextStreetId == NO_NEXT_STREET) {
+        currentTravelDistance += currentStreet.getLength() - currentDistance;
+        break;
+      }
 
-        // if the car left the current street count it to the current streets throughput and determine the next street
-        if (currentDistance >= currentStreet->getLength()) {
-          currentDistance -= currentStreet->getLength(); // update distance
-
-          // Route planning: determine the next street
-          const Junction &targetJunction = currentStreet->getTargetJunction();
-          // determine cardinal direction of the current street
-          CardinalDirection sourceDirection =
-              NORTH; // only to suppress warnings, this value should never actually be used
-          for (const auto &connectedStreet : targetJunction.getIncomingStreets()) {
-            if (connectedStreet.isConnected() && connectedStreet.getStreet()->getId() == currentStreet->getId()) {
-              sourceDirection = connectedStreet.getDirection();
-            }
-          }
+      // leave the current street and continue on the next street of the route
+      timeStep += stepsToStreetEnd;
+      currentTravelDistance += stepsToStreetEnd * velocity;
+      currentDistance += stepsToStreetEnd * velocity - currentStreet.getLength();
+      currentStreetId    = nextStreetId;
+      turnDirectionIndex = (turnDirectionIndex + 1) % route.size();
+    }
+    optimalTravelDistancePerCar[carId] = currentTravelDistance; // write back the computed travel distance
+  }
+
+  // Sorts the crossings of all threads by street while retaining their order and sums the prioritized throughput.
+  void mergeTrafficLightCrossings(const std::vector<std::vector<TrafficLightCrossing>> &crossingsPerThread) {
+    // count the crossings per street and determine the offset of each street
+    for (const auto &crossings : crossingsPerThread) {
+      for (const auto &crossing : crossings) { ++trafficLightCrossingOffsetPerStreet[crossing.streetId + 1]; }
+    }
+    for (unsigned streetId = 0; streetId < streetCount; ++streetId) {
+      trafficLightCrossingOffsetPerStreet[streetId + 1] += trafficLightCrossingOffsetPerStreet[streetId];
+    }
 
-          // determine the preferred cardinal direction of the new street
-          TurnDirection turnDirection     = route[turnDirectionIndex % 4];
-          CardinalDirection nextDirection = (CardinalDirection)((sourceDirection + turnDirection) % 4);
+    // place the crossings at the next free position of their street
+    trafficLightCrossings.resize(trafficLightCrossingOffsetPerStreet[streetCount], TrafficLightCrossing(0, 0, 0));
+    std::vector<std::size_t> nextPosition(
+        trafficLightCrossingOffsetPerStreet.begin(), trafficLightCrossingOffsetPerStreet.end() - 1);
+    for (const auto &crossings : crossingsPerThread) {
+      for (const auto &crossing : crossings) {
+        trafficLightCrossings[nextPosition[crossing.streetId]++] = crossing;
+        prioritizedThroughputPerStreet[crossing.streetId] += optimalTravelDistancePerCar[crossing.carId];
+      }
+    }
+  }
 
-          // search for the next connected street in the preferred direction
+  // Determines for each street and turn direction the street a car takes at the target junction of the street.
+  // The preferred cardinal direction is derived from the direction of the street at its target junction and the turn
+  // direction. If there is no street in that direction, the next connected street in clockwise order is taken.
+  void determineNextStreets() {
+    for (const auto &junction : domainModel.getJunctions()) {
+      for (const auto &incomingStreet : junction.getIncomingStreets()) {
+        if (!incomingStreet.isConnected()) { continue; }
+        for (unsigned turnDirection = UTURN; turnDirection <= RIGHT; ++turnDirection) {
           for (unsigned i = 0; i < 4; ++i) {
-            auto outgoingStreet = targetJunction.getOutgoingStreet((CardinalDirection)((nextDirection + i) % 4));
+            auto direction      = (CardinalDirection)((incomingStreet.getDirection() + turnDirection + i) % 4);
+            auto outgoingStreet = junction.getOutgoingStreet(direction);
             if (outgoingStreet.isConnected()) {
-              currentStreet = outgoingStreet.getStreet();
+              nextStreet[incomingStreet.getStreet()->getId()][turnDirection] = outgoingStreet.getStreet()->getId();
               break;
             }
           }
         }
       }
-      optimalTravelDistancePerCar[carId] = currentTravelDistance; // write back the computed travel distance
     }
   }
 
+public:
+  // Returns the highest speed limit of all streets a car can ever drive on. The route is followed cyclically, i.e. the
+  // streets of a car repeat as soon as it reaches a street again at the same position in its route.
+  double getMaxSpeedLimitOnRoute(const unsigned carId) const {
+    const Vehicle &car = domainModel.getVehicles()[carId];
+    const auto &route  = car.getRoute();
+
+    std::unordered_set<std::size_t> visited; // by street id and position in the route
+    unsigned currentStreetId    = car.getPosition().getStreet()->getId();
+    unsigned turnDirectionIndex = 0;
+    double maxSpeedLimit        = 0;
+    while (visited.insert(std::size_t(currentStreetId) * route.size() + turnDirectionIndex).second) {
+      maxSpeedLimit = std::max(maxSpeedLimit, domainModel.getStreets()[currentStreetId].getSpeedLimit());
+      if (route.empty()) { break; }
+      currentStreetId = nextStreet[currentStreetId][route[turnDirectionIndex]];
+      if (currentStreetId == NO_NEXT_STREET) { break; }
+      turnDirectionIndex = (turnDirectionIndex + 1) % route.size();
+    }
+    return maxSpeedLimit;
+  }
+
   double getTravelDistance(const unsigned carId) const { return optimalTravelDistancePerCar[carId]; }
   // The priority of a car is equivalent to its optimal travel distance.
   double getCarPriority(const unsigned carId) const { return optimalTravelDistancePerCar[carId]; }
@@ -102,30 +211,24 @@ public:
   // The throughput of a street is the total number of cars that crossed the streets traffic light during the heuristic
   // simulation.
   unsigned getTrafficLightThroughput(const unsigned streetId) const {
-    return trafficLightCrossingsPerStreet[streetId].size();
+    return trafficLightCrossingOffsetPerStreet[streetId + 1] - trafficLightCrossingOffsetPerStreet[streetId];
   }
   // The prioritized throughput is the throughput multiplied by the priority of each car.
   double getPrioritizedTrafficLightThroughput(const unsigned streetId) const {
-    double prioritizedThroughput = 0;
-    for (unsigned carId = 0; carId < carCount; ++carId) {
-      prioritizedThroughput +=
-          optimalTravelDistancePerCar[carId] * trafficLightCrossingCountPerCarPerStreet[carId][streetId];
-    }
-    return prioritizedThroughput;
+    return prioritizedThroughputPerStreet[streetId];
   }
 
-  const std::vector<TrafficLightCrossing>& getTrafficLightCrossings(const unsigned streetId) const {
-    return trafficLightCrossingsPerStreet[streetId];
+  TrafficLightCrossingRange getTrafficLightCrossings(const unsigned streetId) const {
+    return TrafficLightCrossingRange(trafficLightCrossings.data() + trafficLightCrossingOffsetPerStreet[streetId],
+        trafficLightCrossings.data() + trafficLightCrossingOffsetPerStreet[streetId + 1]);
   }
 
   // Resets results computed by the heuristic simulation
   void reset() {
     std::fill(optimalTravelDistancePerCar.begin(), optimalTravelDistancePerCar.end(), 0.0);
-    for (unsigned carId = 0; carId < carCount; ++carId) {
-      std::fill(trafficLightCrossingCountPerCarPerStreet[carId].begin(),
-          trafficLightCrossingCountPerCarPerStreet[carId].end(), 0);
-    }
-    for (unsigned streetId = 0; streetId < carCount; ++streetId) { trafficLightCrossingsPerStreet[streetId].clear(); }
+    std::fill(prioritizedThroughputPerStreet.begin(), prioritizedThroughputPerStreet.end(), 0.0);
+    std::fill(trafficLightCrossingOffsetPerStreet.begin(), trafficLightCrossingOffsetPerStreet.end(), 0);
+    trafficLightCrossings.clear();
   }
 };
 
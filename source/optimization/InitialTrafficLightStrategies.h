@@ -1,6 +1,8 @@
 #ifndef INITIAL_TRAFFIC_LIGTH_STRATEGIES
 #define INITIAL_TRAFFIC_LIGTH_STRATEGIES
 
+#include <algorithm>
+
 #include "DomainModel.h"
 #include "HeuristicSimulator.h"
 #include "Junction.h"
@@ -15,14 +17,14 @@ struct InitialTrafficLightsAllFive {
    */
   void operator()(DomainModel &domainModel) const {
     const unsigned signalDuration = 5;
-    for (auto const &junction : domainModel.getJunctions()) {
+    for (auto &junction : domainModel.getJunctions()) {
       std::vector<Junction::Signal> initialSignals;
-      for (auto const &connectedStreet : junction->getIncomingStreets()) {
+      for (auto const &connectedStreet : junction.getIncomingStreets()) {
         if (connectedStreet.isConnected()) {
           initialSignals.push_back(Junction::Signal(connectedStreet.getDirection(), signalDuration));
         }
       }
-      junction->setSignals(initialSignals);
+      junction.setSignals(initialSignals);
     }
   }
   void operator()(DomainModel &domainModel, const unsigned) { operator()(domainModel); }
@@ -57,10 +59,10 @@ struct InitialTrafficLightsWithHeuristicSimulator {
     simulator.performSteps(stepCount);
 
     const unsigned baseDuration = 5;
-    for (auto const &junction : domainModel.getJunctions()) {
+    for (auto &junction : domainModel.getJunctions()) {
       std::vector<Junction::Signal> initialSignals;
       double totalThroughput = 0.0;
-      for (auto const &connectedStreet : junction->getIncomingStreets()) {
+      for (auto const &connectedStreet : junction.getIncomingStreets()) {
         if (connectedStreet.isConnected()) {
           totalThroughput += getThroughput(simulator, connectedStreet.getStreet()->getId());
         }
@@ -69,14 +71,14 @@ struct InitialTrafficLightsWithHeuristicSimulator {
       // if no car will ever cross this junction the signals are irrelevant.
       // We, therefore, set a signal only for the first connected street with the base duration.
       if (totalThroughput == 0) {
-        for (auto const &connectedStreet : junction->getIncomingStreets()) {
+        for (auto const &connectedStreet : junction.getIncomingStreets()) {
           if (connectedStreet.isConnected()) {
             initialSignals.push_back(Junction::Signal(connectedStreet.getDirection(), baseDuration));
             break;
           }
         }
       } else { // otherwise determine signal durations based on the relative throughput
-        for (auto const &connectedStreet : junction->getIncomingStreets()) {
+        for (auto const &connectedStreet : junction.getIncomingStreets()) {
           if (connectedStreet.isConnected()) {
             double throughput = getThroughput(simulator, connectedStreet.getStreet()->getId());
             if (throughput == 0) { continue; } // skip streets with no throughput
@@ -85,7 +87,7 @@ struct InitialTrafficLightsWithHeuristicSimulator {
           }
         }
       }
-      junction->setSignals(initialSignals);
+      junction.setSignals(initialSignals);
     }
   }
 };
@@ -106,48 +108,70 @@ struct InitialTrafficLightsWithHeuristicSimulatorAndIteration {
     }
   }
 
-  double getWaitTime(const RateTrafficLights &rating, const unsigned streetId) const {
+  double getWaitTime(const CycleTrafficLightRating &rating, const unsigned streetIndex, const unsigned offset,
+      const unsigned duration) const {
 #if __cpp_if_constexpr >= 201606
     if constexpr (withPriority) {
 #else
     if (withPriority) {
 #endif
-      return rating.getWaitTimeWithPriority(streetId);
+      return rating.getWaitTimeWithPriority(streetIndex, offset, duration);
     } else {
-      return rating.getWaitTime(streetId);
+      return rating.getWaitTime(streetIndex, offset, duration);
     }
   }
 
-  double getTotalWaitTime(const RateTrafficLights &rating) const {
-#if __cpp_if_constexpr >= 201606
-    if constexpr (withPriority) {
-#else
-    if (withPriority) {
-#endif
-      return rating.getTotalWaitTimeWithPriority();
-    } else {
-      return rating.getTotalWaitTime();
-    }
-  }
+  /**
+   * Branch-and-bound search for the traffic light order with minimal total wait time for fixed durations.
+   * Orders are built signal by signal, a partial order is discarded once its wait time reaches the best known total.
+   * Orders are visited in lexicographic order, so ties are resolved like an exhaustive search over all permutations.
+   */
+  class OrderSearch {
+    const InitialTrafficLightsWithHeuristicSimulatorAndIteration &strategy;
+    const CycleTrafficLightRating &rating;
+    const std::vector<unsigned> &trafficLightDuration;
+    const unsigned streetCount;
 
-  std::pair<double, std::vector<unsigned>> determineBestOrder(
-      const std::vector<std::vector<TrafficLightCrossing>> &crossingsPerStreet,
-      const std::vector<unsigned> &trafficLightDuration, const std::vector<double> *carPriorities) const {
+    std::vector<unsigned> currentOrder;
+    std::vector<bool> isPlaced;
+
+  public:
     double minimumWaitTime = -1;
     std::vector<unsigned> bestOrder;
 
-    std::vector<unsigned> currentOrder(trafficLightDuration.size());
-    for (unsigned i = 0; i < currentOrder.size(); ++i) { currentOrder[i] = i; }
+    OrderSearch(const InitialTrafficLightsWithHeuristicSimulatorAndIteration &_strategy,
+        const CycleTrafficLightRating &_rating, const std::vector<unsigned> &_trafficLightDuration)
+        : strategy(_strategy), rating(_rating), trafficLightDuration(_trafficLightDuration),
+          streetCount(_trafficLightDuration.size()), currentOrder(streetCount), isPlaced(streetCount, false) {}
 
-    do { // determine order with minimal wait time for each possible permutation of the traffic light order
-      RateTrafficLights rating(crossingsPerStreet, trafficLightDuration, currentOrder, carPriorities);
-      double totalWaitTime = getTotalWaitTime(rating);
-      if (minimumWaitTime < 0 || totalWaitTime < minimumWaitTime) {
-        minimumWaitTime = totalWaitTime;
+    // Completes the current order from 'position' on, the traffic lights placed so far are green until 'offset' and
+    // cause a wait time of 'waitTime'.
+    void search(const unsigned position, const unsigned offset, const double waitTime) {
+      if (minimumWaitTime >= 0 && waitTime >= minimumWaitTime) { return; } // wait times are non-negative, prune
+      if (position == streetCount) {
+        minimumWaitTime = waitTime;
         bestOrder       = currentOrder;
+        return;
       }
-    } while (std::next_permutation(currentOrder.begin(), currentOrder.end()));
-    return std::make_pair(minimumWaitTime, bestOrder); // return the best order and its total wait time
+      for (unsigned streetIndex = 0; streetIndex < streetCount; ++streetIndex) {
+        if (isPlaced[streetIndex]) { continue; }
+        const unsigned duration = trafficLightDuration[streetIndex];
+        isPlaced[streetIndex]   = true;
+        currentOrder[position]  = streetIndex;
+        search(position + 1, offset + duration,
+            waitTime + strategy.getWaitTime(rating, streetIndex, offset, duration));
+        isPlaced[streetIndex] = false;
+      }
+    }
+
+    void run() { search(0, 0, 0); }
+  };
+
+  std::pair<double, std::vector<unsigned>> determineBestOrder(
+      const CycleTrafficLightRating &rating, const std::vector<unsigned> &trafficLightDuration) const {
+    OrderSearch orderSearch(*this, rating, trafficLightDuration);
+    orderSearch.run();
+    return std::make_pair(orderSearch.minimumWaitTime, orderSearch.bestOrder); // return the best order and wait time
   }
 
   void optimizeSignals(const HeuristicSimulator &simulator, std::vector<unsigned> &trafficLightDuration,
@@ -163,15 +187,19 @@ struct InitialTrafficLightsWithHeuristicSimulatorAndIteration {
     const unsigned maxCyclesWithoutImprovement = 5;
 
     // retrieve information from the simulator
-    std::vector<std::vector<TrafficLightCrossing>> crossingsPerStreet(streetIds.size());
-    for (unsigned streetIndex = 0; streetIndex < streetIds.size(); ++streetIndex) {
-      crossingsPerStreet[streetIndex] = simulator.getTrafficLightCrossings(streetIds[streetIndex]);
+    std::vector<TrafficLightCrossingRange> crossingsPerStreet;
+    for (const unsigned streetId : streetIds) {
+      crossingsPerStreet.push_back(simulator.getTrafficLightCrossings(streetId));
     }
 
     while (true) {
       // evaluate the current traffic light duration and find the best order
+      unsigned cycleLength = 0;
+      for (const unsigned duration : currentDuration) { cycleLength += duration; }
+      CycleTrafficLightRating rating(crossingsPerStreet, cycleLength, carPriorities);
+
       double totalWaitTime;
-      std::tie(totalWaitTime, currentOrder) = determineBestOrder(crossingsPerStreet, currentDuration, carPriorities);
+      std::tie(totalWaitTime, currentOrder) = determineBestOrder(rating, currentDuration);
 
       // if improvement over current optimum set as new optimum and reset cyclesWithoutImprovement count
       if (bestRating < 0 || totalWaitTime < bestRating) {
@@ -186,9 +214,14 @@ struct InitialTrafficLightsWithHeuristicSimulatorAndIteration {
       if (totalWaitTime <= 0) { break; } // stop if optimal wait time reached
 
       // improve the traffic lights, use cycle count to diversify solutions when retrying from the same optimum
-      RateTrafficLights rating(crossingsPerStreet, currentDuration, currentOrder, carPriorities);
+      std::vector<unsigned> offset(streetIds.size());
+      for (unsigned streetIndex = 0, currentOffset = 0; streetIndex < currentOrder.size(); ++streetIndex) {
+        offset[currentOrder[streetIndex]] = currentOffset;
+        currentOffset += currentDuration[currentOrder[streetIndex]];
+      }
       for (unsigned streetIndex = 0; streetIndex < streetIds.size(); ++streetIndex) {
-        double relativeRating = getWaitTime(rating, streetIndex) / totalWaitTime;
+        double relativeRating =
+            getWaitTime(rating, streetIndex, offset[streetIndex], currentDuration[streetIndex]) / totalWaitTime;
         currentDuration[streetIndex] += (5 + cyclesWithoutImprovement) * relativeRating;
         assert(currentDuration[streetIndex] >= 5);
       }
@@ -211,13 +244,16 @@ struct InitialTrafficLightsWithHeuristicSimulatorAndIteration {
     simulator.performSteps(stepCount);
 
     const unsigned baseDuration = 5;
-    for (auto const &junction : domainModel.getJunctions()) {
-      std::vector<std::vector<TrafficLightCrossing>> crossingsPerStreet;
+    auto &junctions             = domainModel.getJunctions();
+    // junctions are optimized independently of each other
+#pragma omp parallel for shared(simulator, junctions) schedule(dynamic)
+    for (std::size_t junctionIndex = 0; junctionIndex < junctions.size(); ++junctionIndex) {
+      auto &junction = junctions[junctionIndex];
 
       std::vector<Junction::Signal> initialSignals;
       double totalThroughput        = 0.0;
       unsigned connectedStreetCount = 0;
-      for (auto const &connectedStreet : junction->getIncomingStreets()) {
+      for (auto const &connectedStreet : junction.getIncomingStreets()) {
         if (connectedStreet.isConnected()) {
           ++connectedStreetCount;
           totalThroughput += getThroughput(simulator, connectedStreet.getStreet()->getId());
@@ -227,13 +263,13 @@ struct InitialTrafficLightsWithHeuristicSimulatorAndIteration {
       // If no car will ever cross this junction or there is only one connected street the signals are irrelevant.
       // We, therefore, set a signal only for the first connected street with the base duration.
       if (totalThroughput == 0 || connectedStreetCount <= 1) {
-        for (auto const &connectedStreet : junction->getIncomingStreets()) {
+        for (auto const &connectedStreet : junction.getIncomingStreets()) {
           if (connectedStreet.isConnected()) {
             initialSignals.push_back(Junction::Signal(connectedStreet.getDirection(), baseDuration));
             break;
           }
         }
-        junction->setSignals(initialSignals);
+        junction.setSignals(initialSignals);
         continue;
       }
 
@@ -242,7 +278,7 @@ struct InitialTrafficLightsWithHeuristicSimulatorAndIteration {
       std::vector<unsigned> signalOrder = {0, 1, 2, 3};
       std::vector<unsigned> streetIds;
       std::vector<CardinalDirection> signalDirections;
-      for (auto const &connectedStreet : junction->getIncomingStreets()) {
+      for (auto const &connectedStreet : junction.getIncomingStreets()) {
         if (connectedStreet.isConnected()) {
           double throughput = getThroughput(simulator, connectedStreet.getStreet()->getId());
           if (throughput == 0) { continue; } // skip streets with no throughput
@@ -259,7 +295,7 @@ struct InitialTrafficLightsWithHeuristicSimulatorAndIteration {
       for (const auto streetIndex : signalOrder) {
         initialSignals.push_back(Junction::Signal(signalDirections[streetIndex], signalDurations[streetIndex]));
       }
-      junction->setSignals(initialSignals);
+      junction.setSignals(initialSignals);
     }
   }
 };
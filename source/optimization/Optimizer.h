@@ -1,14 +1,32 @@
 #ifndef OPTIMIZER_H
 #define OPTIMIZER_H
 
+#include "AccelerationComputer.h"
+#include "AnnealingSignalPlanSearch.h"
 #include "DomainModel.h"
+#include "HeuristicSimulator.h"
 #include "Junction.h"
+#include "OptimizationRoutineTraits.h"
+#include "RegionalDecomposition.h"
 #include "Simulator.h"
 
+#include <algorithm>
 #include <iomanip>
 #include <iostream>
+#include <limits>
+#include <stdexcept>
 #include <vector>
 
+/**
+ * Checks whether successive halving on 'fidelityLevels' levels is possible with 'candidateCount' candidates, i.e. the
+ * initial population of 'candidateCount' * 2^(fidelityLevels - 1) plans can be counted.
+ */
+inline bool isValidFidelityLevelCount(const unsigned candidateCount, const unsigned fidelityLevels) {
+  const unsigned maxShift = std::numeric_limits<unsigned>::digits - 1;
+  return fidelityLevels >= 1 && fidelityLevels - 1 <= maxShift &&
+         std::max(candidateCount, 1u) <= (std::numeric_limits<unsigned>::max() >> (fidelityLevels - 1));
+}
+
 template <template <typename Vehicle> typename RfbStructure,
     template <template <typename Vehicle> typename _RfbStructure> typename SignalingRoutine,
     template <template <typename Vehicle> typename _RfbStructure> typename IDMRoutine,
@@ -17,44 +35,404 @@ template <template <typename Vehicle> typename RfbStructure,
     typename InitialTrafficLightStrategy, bool debug = false>
 class Optimizer {
   using SimulatorType = Simulator<RfbStructure, SignalingRoutine, IDMRoutine, OptimizationRoutine, ConsistencyRoutine>;
+  using optimization_category =
+      typename optimizationroutine_traits<OptimizationRoutine<RfbStructure>>::optimization_category;
+  using SignalPlan = std::vector<std::vector<Junction::Signal>>;
 
   DomainModel &domainModel;
   const double minTravelDistance;
   const unsigned stepCount;
   double lastTravelDistance = 0;
   unsigned maxCycles        = -1;
+  unsigned candidateCount   = 1;
+  // number of horizons signal plans are screened on before the survivors are simulated completely
+  unsigned fidelityLevels = 1;
+  // simulated steps and the steps required to simulate all evaluated signal plans completely
+  unsigned long long simulatedSteps    = 0;
+  unsigned long long fullFidelitySteps = 0;
+  // number of signal plans evaluated on each fidelity level, the last level simulates them completely
+  std::vector<unsigned long long> evaluatedPlansPerLevel;
+  // upper bound on the distance all cars together can travel in a single step
+  double maxStepTravelDistance = std::numeric_limits<double>::infinity();
+  // snapshot of the low level model in its initial state, restored at the beginning of each optimization cycle
+  typename SimulatorType::Snapshot initialLowLevel;
 
 private:
   /** Set the initial traffic ligths based on the initial traffic light strategy. */
   void setInitialTrafficLights() { InitialTrafficLightStrategy()(domainModel, stepCount); }
 
+  /**
+   * Determines the upper bound on the travel distance per step. A car travels its velocity in each step, which never
+   * exceeds the velocity reachable with the highest speed limit on its route, see getMaxReachableVelocity().
+   */
+  void determineMaxStepTravelDistance() {
+    const HeuristicSimulator heuristicSimulator(domainModel);
+    const auto &vehicles  = domainModel.getVehicles();
+    maxStepTravelDistance = 0;
+    for (unsigned carId = 0; carId < vehicles.size(); ++carId) {
+      const double maxSpeedLimit   = heuristicSimulator.getMaxSpeedLimitOnRoute(carId);
+      const double desiredVelocity = std::min(vehicles[carId].getTargetVelocity(), maxSpeedLimit);
+      maxStepTravelDistance += getMaxReachableVelocity(desiredVelocity, vehicles[carId].getMaxAcceleration());
+    }
+  }
+
+  /** Builds the low level model once and stores a snapshot of it to be restored in each optimization cycle. */
+  void takeInitialSnapshot() {
+    domainModel.resetModel();
+    initialLowLevel = SimulatorType(domainModel).takeSnapshot();
+  }
+
   /**
    * Iterate over all cars on all streets and sum their travel distance to the total travel distance.
-   * Store the computed distance in lastTravelDistance
    * @param[in]  simulator          The simulator running the simulation (and holding the low level model)
+   * @return     The total travel distance of all cars
    */
-  void calculateTravelDistance(const SimulatorType &simulator) {
+  double calculateTravelDistance(const SimulatorType &simulator) const {
     double travelDistance = 0;
     for (auto &street : simulator.getData().getStreets()) {
       for (const auto &car : street.allIterable()) { travelDistance += car.getTravelDistance(); }
     }
-    lastTravelDistance = travelDistance;
+    return travelDistance;
+  }
+
+  /**
+   * Sums the distance all cars traveled in the last step, i.e. their current velocity.
+   * @param[in]  simulator          The simulator running the simulation (and holding the low level model)
+   * @return     The travel distance of all cars in the last step
+   */
+  double calculateStepTravelDistance(const SimulatorType &simulator) const {
+    double stepTravelDistance = 0;
+    const auto &streets       = simulator.getData().getStreets();
+#pragma omp parallel for reduction(+ : stepTravelDistance) schedule(static)
+    for (std::size_t i = 0; i < streets.size(); ++i) {
+      for (const auto &car : streets[i].allIterable()) { stepTravelDistance += car.getVelocity(); }
+    }
+    return stepTravelDistance;
   }
 
   /**
-   * Resets the domain model, initializes a new simulator and runs a simulation of 'stepCount' steps while
-   * evaluating the traffic lights. Returns directly if the simulation reached the required minimum travel distance.
-   * Otherwise optimizes the traffic lights based on the evaluation.
+   * Decides after each step whether the result of the current optimization cycle is already determined.
+   * This is the case if the minimum travel distance is reached, as the travel distance can only grow in later steps,
+   * or if it can no longer be reached even if all cars drive at their maximum velocity in the remaining steps.
+   * @param[in]  simulator              The simulator running the simulation
+   * @param[in]  performedSteps         The number of steps performed so far
+   * @param      runningTravelDistance  The travel distance of all cars so far, updated by the step's travel distance
+   * @return     True if the simulation can be stopped
    */
-  void runOptimizationCycle() {
-    domainModel.resetModel(); // reset cars and signals to initial state
-    // run a complete simulation using a newly initialized simulator, evaluate the traffic lights during the simulation
-    SimulatorType simulator(domainModel);
-    simulator.performSteps(stepCount);
+  bool isCycleDecided(
+      const SimulatorType &simulator, const unsigned performedSteps, double &runningTravelDistance) const {
+    runningTravelDistance += calculateStepTravelDistance(simulator);
+    if (runningTravelDistance >= minTravelDistance) { // confirm with the exact sum to be robust against rounding
+      return calculateTravelDistance(simulator) >= minTravelDistance;
+    }
+    double reachableTravelDistance = runningTravelDistance + (stepCount - performedSteps) * maxStepTravelDistance;
+    return reachableTravelDistance < minTravelDistance;
+  }
+
+  /**
+   * Runs a simulation of 'stepCount' steps which is stopped early once its result is decided, see isCycleDecided().
+   * @param      simulator  The simulator running the simulation
+   * @return     The number of performed steps
+   */
+  unsigned simulateUntilDecided(SimulatorType &simulator) const {
+    double runningTravelDistance = 0;
+    return simulator.performStepsUntil(stepCount, [&](const unsigned performedSteps) {
+      return isCycleDecided(simulator, performedSteps, runningTravelDistance);
+    });
+  }
 
-    calculateTravelDistance(simulator);                        // compute the traveled distance
-    if (lastTravelDistance >= minTravelDistance) { return; }   // check whether the minimum travel distance is reached
+  /**
+   * Resets the given domain model, initializes a new simulator and runs a simulation of 'stepCount' steps while
+   * evaluating the traffic lights. The simulation is stopped early once its result is decided, see isCycleDecided().
+   * Returns directly if the simulation reached the required minimum travel distance.
+   * Otherwise optimizes the traffic lights of the given domain model based on the evaluation. The evaluation of a
+   * stopped simulation covers only its first steps.
+   * @param      model           The domain model holding the signal plan to evaluate
+   * @param      performedSteps  Is set to the number of simulated steps
+   * @return     The total travel distance reached with the evaluated signal plan until the simulation was stopped
+   */
+  double runOptimizationCycle(DomainModel &model, unsigned &performedSteps) {
+    model.resetModel(); // reset cars and signals to initial state
+    // run a complete simulation using a simulator initialized from the snapshot, evaluate the traffic lights meanwhile
+    SimulatorType simulator(model, initialLowLevel);
+    performedSteps = simulateUntilDecided(simulator);
+
+    double travelDistance = calculateTravelDistance(simulator);         // compute the traveled distance
+    if (travelDistance >= minTravelDistance) { return travelDistance; } // check whether the minimum is reached
     simulator.getOptimizationRoutine().improveTrafficLights(); // optimize the traffic lights based on the evaluation
+    return travelDistance;
+  }
+
+  /** Rating of a signal plan for a search engine. */
+  struct SignalPlanEvaluation {
+    double fitness          = 0;
+    double travelDistance   = 0;
+    unsigned performedSteps = 0;
+  };
+
+  /**
+   * Resets the given domain model and simulates its signal plan to rate it for a search engine. A simulation stopped
+   * early is rated by extrapolating its travel distance to all steps. Thereby, only plans reaching the minimum travel
+   * distance are rated above it, plans which cannot reach it are rated below.
+   * @param      model  The domain model holding the signal plan to evaluate
+   * @return     The fitness, travel distance and number of simulated steps
+   */
+  SignalPlanEvaluation evaluateSignalPlan(DomainModel &model) const {
+    model.resetModel();
+    SimulatorType simulator(model, initialLowLevel);
+    SignalPlanEvaluation evaluation;
+    evaluation.performedSteps = simulateUntilDecided(simulator);
+    evaluation.travelDistance = calculateTravelDistance(simulator);
+    evaluation.fitness        = evaluation.travelDistance;
+    if (evaluation.performedSteps > 0) { evaluation.fitness *= double(stepCount) / evaluation.performedSteps; }
+    return evaluation;
+  }
+
+  /**
+   * Resets the given domain model and simulates only the first 'horizon' steps of its signal plan. The plan is rated by
+   * the travel distance reached within these steps.
+   * @param      model    The domain model holding the signal plan to evaluate
+   * @param[in]  horizon  The number of steps to simulate
+   * @return     The fitness, travel distance and number of simulated steps
+   */
+  SignalPlanEvaluation evaluateSignalPlan(DomainModel &model, const unsigned horizon) const {
+    model.resetModel();
+    SimulatorType simulator(model, initialLowLevel);
+    simulator.performSteps(horizon);
+    SignalPlanEvaluation evaluation;
+    evaluation.performedSteps = horizon;
+    evaluation.travelDistance = calculateTravelDistance(simulator);
+    evaluation.fitness        = evaluation.travelDistance;
+    return evaluation;
+  }
+
+  /**
+   * Evaluates the signal plans of the population given by 'selection' concurrently, each one on its own domain model.
+   * A 'horizon' of 0 denotes a complete simulation.
+   */
+  void evaluatePopulation(std::vector<DomainModel> &models, const std::vector<SignalPlan> &population,
+      const std::vector<std::size_t> &selection, std::vector<SignalPlanEvaluation> &evaluations,
+      const unsigned horizon) {
+#pragma omp parallel for shared(models, population, selection, evaluations) schedule(dynamic, 1)
+    for (std::size_t i = 0; i < selection.size(); ++i) {
+      const std::size_t candidate = selection[i];
+      setSignalPlan(models[candidate], population[candidate]);
+      evaluations[candidate] = (horizon == 0) ? evaluateSignalPlan(models[candidate])
+                                              : evaluateSignalPlan(models[candidate], horizon);
+    }
+    for (const std::size_t candidate : selection) { simulatedSteps += evaluations[candidate].performedSteps; }
+  }
+
+  /** Returns the signals of all junctions of the given domain model, i.e. its signal plan. */
+  SignalPlan getSignalPlan(const DomainModel &model) const {
+    SignalPlan signalPlan;
+    signalPlan.reserve(model.getJunctions().size());
+    for (const auto &junction : model.getJunctions()) { signalPlan.push_back(junction.getSignals()); }
+    return signalPlan;
+  }
+
+  /** Sets the signals of all junctions of the given domain model to the given signal plan. */
+  void setSignalPlan(DomainModel &model, const SignalPlan &signalPlan) const {
+    for (auto &junction : model.getJunctions()) { junction.setSignals(signalPlan[junction.getId()]); }
+  }
+
+  /**
+   * Runs the optimization cycles for 'candidateCount' candidates concurrently. The simulators of all candidates start
+   * from the same snapshot of the low level model and share its routing table. Each candidate owns a copy of the domain
+   * model, taken once before the first cycle, as the junctions hold its signal plan and signal state and the vehicles
+   * its positions. The plan is evaluated and improved by the candidate's own simulator. The first candidate starts from
+   * the initial signal plan, the others from random perturbations of it, as the same plan would otherwise be simulated
+   * by all candidates in the first batch. After each batch of cycles the best evaluated signal plan is kept. Once a
+   * candidate reaches the minimum travel distance or the maximum number of cycles is reached, the best signal plan is
+   * written to the domain model.
+   */
+  void optimizeTrafficLightsInParallel() {
+    std::vector<DomainModel> candidates;
+    candidates.reserve(candidateCount);
+    const std::vector<SignalPlan> initialPlans =
+        AnnealingSignalPlanSearch(domainModel).proposePopulation(candidateCount);
+    for (unsigned i = 0; i < candidateCount; ++i) {
+      candidates.emplace_back(domainModel);
+      setSignalPlan(candidates[i], initialPlans[i]);
+    }
+
+    std::vector<double> travelDistances(candidateCount, 0);
+    std::vector<unsigned> performedSteps(candidateCount, 0);
+    std::vector<SignalPlan> evaluatedPlans(candidateCount);
+    SignalPlan bestPlan             = getSignalPlan(domainModel);
+    unsigned optimizationCycleCount = 0;
+    while (lastTravelDistance < minTravelDistance && optimizationCycleCount < maxCycles) {
+#pragma omp parallel for shared(candidates, travelDistances, performedSteps, evaluatedPlans) schedule(dynamic, 1)
+      for (std::size_t i = 0; i < candidates.size(); ++i) {
+        evaluatedPlans[i]  = getSignalPlan(candidates[i]); // the cycle may change the plan after evaluating it
+        travelDistances[i] = runOptimizationCycle(candidates[i], performedSteps[i]);
+      }
+
+      // keep the best signal plan evaluated so far
+      for (unsigned i = 0; i < candidateCount; ++i) {
+        simulatedSteps += performedSteps[i];
+        fullFidelitySteps += stepCount;
+        if (travelDistances[i] > lastTravelDistance) {
+          lastTravelDistance = travelDistances[i];
+          bestPlan           = std::move(evaluatedPlans[i]);
+        }
+      }
+      ++optimizationCycleCount;
+      if (debug) { printOptimizationProgress(optimizationCycleCount); }
+    }
+    setSignalPlan(domainModel, bestPlan);
+  }
+
+  /** Runs the optimization cycles of the optimization routine, concurrently for multiple candidates if requested. */
+  void runOptimization(optimizationroutine_cycle_tag) {
+    if (candidateCount > 1) {
+      optimizeTrafficLightsInParallel();
+      return;
+    }
+    unsigned optimizationCycleCount = 0;
+    while (lastTravelDistance < minTravelDistance && optimizationCycleCount < maxCycles) {
+      unsigned performedSteps = 0;
+      lastTravelDistance      = runOptimizationCycle(domainModel, performedSteps);
+      simulatedSteps += performedSteps;
+      fullFidelitySteps += stepCount;
+      ++optimizationCycleCount;
+      if (debug) { printOptimizationProgress(optimizationCycleCount); }
+    }
+  }
+
+  /**
+   * Optimizes the signal plan with the search engine of the optimization routine, which is initialized from the domain
+   * model. In each generation the search engine proposes 'candidateCount' signal plans, which are evaluated
+   * concurrently on independent copies of the domain model. Stops once a plan reaches the minimum travel distance or
+   * after 'maxCycles' generations and writes the best plan to the domain model.
+   *
+   * With more than one fidelity level the plans are screened by successive halving: the search engine proposes
+   * 'candidateCount' * 2^(fidelityLevels - 1) plans, which are simulated on a short horizon. The better half is
+   * promoted to a horizon twice as long until 'candidateCount' plans remain, which are simulated completely and
+   * reported to the search engine.
+   */
+  void runOptimization(optimizationroutine_search_engine_tag) {
+    using SearchEngine = typename optimizationroutine_traits<OptimizationRoutine<RfbStructure>>::SearchEngine;
+    SearchEngine searchEngine(domainModel);
+
+    const unsigned populationSize = candidateCount << (fidelityLevels - 1);
+    std::vector<DomainModel> candidates;
+    candidates.reserve(populationSize);
+    for (unsigned i = 0; i < populationSize; ++i) { candidates.emplace_back(domainModel); }
+
+    std::vector<SignalPlanEvaluation> evaluations(populationSize);
+    double bestFitness              = -std::numeric_limits<double>::infinity();
+    unsigned optimizationCycleCount = 0;
+    while (lastTravelDistance < minTravelDistance && optimizationCycleCount < maxCycles) {
+      const std::vector<SignalPlan> population = searchEngine.proposePopulation(populationSize);
+      std::vector<std::size_t> survivors(population.size());
+      for (std::size_t i = 0; i < survivors.size(); ++i) { survivors[i] = i; }
+      fullFidelitySteps += static_cast<unsigned long long>(population.size()) * stepCount;
+
+      // screen the population on increasing horizons and keep the better half on each level
+      for (unsigned level = 1; level < fidelityLevels; ++level) {
+        const unsigned horizon = std::max(stepCount >> (fidelityLevels - level), 1u);
+        evaluatePopulation(candidates, population, survivors, evaluations, horizon);
+        evaluatedPlansPerLevel[level - 1] += survivors.size();
+        std::stable_sort(survivors.begin(), survivors.end(), [&](const std::size_t a, const std::size_t b) {
+          return evaluations[a].fitness > evaluations[b].fitness;
+        });
+        survivors.resize(survivors.size() / 2);
+      }
+      evaluatePopulation(candidates, population, survivors, evaluations, 0);
+      evaluatedPlansPerLevel[fidelityLevels - 1] += survivors.size();
+
+      std::vector<SignalPlan> evaluatedPlans;
+      std::vector<double> fitness;
+      for (const std::size_t candidate : survivors) {
+        evaluatedPlans.push_back(population[candidate]);
+        fitness.push_back(evaluations[candidate].fitness);
+        // the fittest plan reaches the minimum travel distance if any does
+        if (evaluations[candidate].fitness > bestFitness) {
+          bestFitness        = evaluations[candidate].fitness;
+          lastTravelDistance = evaluations[candidate].travelDistance;
+        }
+      }
+      searchEngine.reportFitness(evaluatedPlans, fitness);
+
+      ++optimizationCycleCount;
+      if (debug) { printOptimizationProgress(optimizationCycleCount); }
+    }
+    setSignalPlan(domainModel, searchEngine.getBestPlan());
+  }
+
+  using Decomposition = RegionalDecomposition<RfbStructure, SimulatorType>;
+
+  /**
+   * Resets the given domain model and simulates it completely while recording the cars entering each region.
+   * @param      model          The domain model holding the signal plan to simulate
+   * @param      decomposition  The regions of the domain model
+   * @param      inflows        Is set to the recorded inflows of each region
+   * @return     The total travel distance reached with the signal plan
+   */
+  double simulateRecordingInflows(
+      DomainModel &model, Decomposition &decomposition, typename Decomposition::Inflows &inflows) {
+    model.resetModel();
+    SimulatorType simulator(model, initialLowLevel);
+    decomposition.startRecording(initialLowLevel, inflows);
+    simulator.performStepsUntil(stepCount, [&](const unsigned performedSteps) {
+      decomposition.recordInflows(simulator.getData(), performedSteps, inflows);
+      return false;
+    });
+    simulatedSteps += stepCount;
+    fullFidelitySteps += stepCount;
+    return calculateTravelDistance(simulator);
+  }
+
+  /**
+   * Optimizes the signal plan region by region, see RegionalDecomposition. A simulation of the whole model records the
+   * cars entering each region. In each cycle the regions are optimized concurrently: a search engine per region
+   * evaluates its signal plans by simulating the neighbourhood of the region with the recorded inflows. The best plans
+   * of all regions are merged and validated by a simulation of the whole model. The merged plan and its inflows are
+   * kept if it reaches a longer travel distance. Stops once the minimum travel distance is reached or after
+   * 'maxCycles' cycles and writes the best plan to the domain model.
+   */
+  void runOptimization(optimizationroutine_region_tag) {
+    using Routine      = OptimizationRoutine<RfbStructure>;
+    using SearchEngine = typename optimizationroutine_traits<Routine>::SearchEngine;
+    Decomposition decomposition(domainModel, Routine::junctionsPerRegion, stepCount);
+
+    typename Decomposition::Inflows inflows;
+    SignalPlan bestPlan             = getSignalPlan(domainModel);
+    lastTravelDistance              = simulateRecordingInflows(domainModel, decomposition, inflows);
+    unsigned optimizationCycleCount = 0;
+    while (lastTravelDistance < minTravelDistance && optimizationCycleCount < maxCycles) {
+      SignalPlan mergedPlan = bestPlan;
+#pragma omp parallel for shared(decomposition, inflows, bestPlan, mergedPlan) schedule(dynamic, 1)
+      for (std::size_t i = 0; i < decomposition.getRegionCount(); ++i) {
+        typename Decomposition::Region region;
+        decomposition.buildRegion(i, bestPlan, initialLowLevel, inflows[i], region);
+        SearchEngine searchEngine(region.model);
+        for (unsigned generation = 0; generation < Routine::generationsPerCycle; ++generation) {
+          const std::vector<SignalPlan> population = searchEngine.proposePopulation(Routine::populationSize);
+          std::vector<double> fitness(population.size());
+          for (std::size_t candidate = 0; candidate < population.size(); ++candidate) {
+            setSignalPlan(region.model, population[candidate]);
+            fitness[candidate] = Decomposition::simulateRegion(region, stepCount);
+          }
+          searchEngine.reportFitness(population, fitness);
+        }
+        Decomposition::mergeRegionPlan(region, searchEngine.getBestPlan(), mergedPlan); // regions are disjoint
+      }
+
+      // validate the merged plan on the whole model
+      typename Decomposition::Inflows mergedInflows;
+      setSignalPlan(domainModel, mergedPlan);
+      const double travelDistance = simulateRecordingInflows(domainModel, decomposition, mergedInflows);
+      if (travelDistance > lastTravelDistance) {
+        lastTravelDistance = travelDistance;
+        bestPlan           = std::move(mergedPlan);
+        inflows            = std::move(mergedInflows);
+      }
+      ++optimizationCycleCount;
+      if (debug) { printOptimizationProgress(optimizationCycleCount); }
+    }
+    setSignalPlan(domainModel, bestPlan);
   }
 
 public:
@@ -63,31 +441,54 @@ public:
    * @param      _domainModel        The domain model for the simulation
    * @param[in]  _stepCount          The number of steps the simulation is run
    * @param[in]  _minTravelDistance  The minimum travel distance that has to be reached by the sum of all cars
+   * @param[in]  _maxCycles          The maximum number of optimization cycles (per candidate)
+   * @param[in]  _candidateCount     The number of candidate signal plans evaluated concurrently in each cycle
+   * @param[in]  _fidelityLevels     The number of horizons for successive halving (only used with a search engine),
+   *                                 see isValidFidelityLevelCount()
    */
-  Optimizer(
-      DomainModel &_domainModel, const unsigned _stepCount, const double _minTravelDistance, unsigned _maxCycles = -1)
-      : domainModel(_domainModel), minTravelDistance(_minTravelDistance), stepCount(_stepCount), maxCycles(_maxCycles) {
+  Optimizer(DomainModel &_domainModel, const unsigned _stepCount, const double _minTravelDistance,
+      unsigned _maxCycles = -1, unsigned _candidateCount = 1, unsigned _fidelityLevels = 1)
+      : domainModel(_domainModel), minTravelDistance(_minTravelDistance), stepCount(_stepCount), maxCycles(_maxCycles),
+        candidateCount(std::max(_candidateCount, 1u)), fidelityLevels(std::max(_fidelityLevels, 1u)),
+        evaluatedPlansPerLevel(fidelityLevels, 0) {
+    if (!isValidFidelityLevelCount(candidateCount, fidelityLevels)) {
+      throw std::invalid_argument("Too many fidelity levels for the number of candidates.");
+    }
   }
 
+  /** Returns the number of signal plans the search engine evaluated on the given fidelity level, counting from 0. */
+  unsigned long long getEvaluatedPlans(const unsigned level) const { return evaluatedPlansPerLevel[level]; }
+
   void printOptimizationProgress(const unsigned cycleCount) const {
     std::cerr << "Optimization Cycle " << std::setw(4) << cycleCount << "    travel distance " << std::setw(8)
               << std::fixed << std::setprecision(2) << lastTravelDistance << "\n";
   }
 
+  /**
+   * Prints how many steps were simulated to evaluate signal plans compared to simulating each plan completely. The
+   * savings result from stopping decided simulations early and from screening plans on short horizons.
+   */
+  void printSimulationEffort() const {
+    const double savedPercentage =
+        fullFidelitySteps == 0 ? 0 : 100.0 * (fullFidelitySteps - simulatedSteps) / fullFidelitySteps;
+    std::cerr << "Simulated " << simulatedSteps << " of " << fullFidelitySteps << " steps, saved " << std::fixed
+              << std::setprecision(1) << savedPercentage << "%\n";
+  }
+
   /**
    * Computes a signal order and duration such that all cars in the simulation travel at least a distance of
    * minTravelDistance. Runs a complete simulation and evaluates the traffic lights. Checks whether the minimum travel
    * distance is reached. Otherwise optimizes the traffic lights based on the evaluation, resets the simulation and
    * repeats this optimization cycle.
+   * If more than one candidate is requested, the candidates are optimized concurrently and the best one is kept.
+   * If the optimization routine provides a search engine, the search engine proposes the signal plans instead. With
+   * a search engine per region, the regions of junctions are optimized independently.
    */
   void optimizeTrafficLights() {
     setInitialTrafficLights();
-    unsigned optimizationCycleCount = 0;
-    while (lastTravelDistance < minTravelDistance && optimizationCycleCount < maxCycles) {
-      runOptimizationCycle();
-      ++optimizationCycleCount;
-      if (debug) { printOptimizationProgress(optimizationCycleCount); }
-    }
+    determineMaxStepTravelDistance();
+    takeInitialSnapshot();
+    runOptimization(optimization_category());
   }
 };
 
@@ -0,0 +1,353 @@
+#ifndef REGIONAL_DECOMPOSITION_H
+#define REGIONAL_DECOMPOSITION_H
+
+#include <algorithm>
+#include <limits>
+#include <memory>
+#include <vector>
+
+#include "AccelerationComputer.h"
+#include "DomainModel.h"
+#include "Junction.h"
+#include "LowLevelCar.h"
+#include "LowLevelStreet.h"
+#include "ModelSyncer.h"
+#include "RoutingTable.h"
+#include "SimulationData.h"
+
+/**
+ * Decomposes the street network of a domain model into regions of junctions, which are simulated independently.
+ *
+ * A car only interacts with the cars and the traffic light of its own street, so junctions far apart barely interact.
+ * The junctions are partitioned into compact regions. The neighbourhood of a region consists of all streets from, to
+ * and between its junctions and is simulated on a model of its own, see buildRegion() and simulateRegion(). Cars
+ * entering the neighbourhood from outside are replayed from a simulation of the whole model, see recordInflows().
+ * Streets leaving the region end at a red light. They are extended such that the queue of leaving cars never reaches
+ * back into the region, i.e. cars leave the region unhindered, and cars are only credited with the distance they
+ * traveled up to the original end of the street.
+ *
+ * With the signal plan of the recording, the simulation of a neighbourhood reproduces the cars on the streets to and
+ * between the junctions of the region exactly. Changing the signals of a region changes the inflows of the adjacent
+ * regions, so merged region plans have to be validated by a simulation of the whole model.
+ *
+ * @tparam     RfbStructure   The underlying data structure of the low level street
+ * @tparam     SimulatorType  The simulator used for the neighbourhoods of the regions
+ */
+template <template <typename Vehicle> typename RfbStructure, typename SimulatorType>
+class RegionalDecomposition {
+public:
+  using SignalPlan = std::vector<std::vector<Junction::Signal>>;
+  using Snapshot   = typename SimulatorType::Snapshot;
+
+  /** A car entering the neighbourhood of a region from outside. */
+  struct BoundaryInflow {
+    unsigned step;     // number of steps performed when the car had entered
+    unsigned streetId; // the street the car entered
+    LowLevelCar car;   // the car on the entered street
+  };
+  // the inflows of each region ordered by step, in terms of the whole model
+  using Inflows = std::vector<std::vector<BoundaryInflow>>;
+
+  /**
+   * The model of the neighbourhood of a region. Its first junctions are the junctions of the region in the order of
+   * 'junctionIds', each street leading to or away from the region has an additional junction at its other end.
+   */
+  struct Region {
+    std::vector<std::size_t> junctionIds; // ids of the junctions of the region in the whole model
+    DomainModel model;
+    Snapshot initialLowLevel;
+    std::vector<BoundaryInflow> inflows; // in terms of the model of the region
+    std::vector<double> streetLengths;   // the length of each street of the model in the whole model
+  };
+
+private:
+  using JunctionIdIterator = std::vector<std::size_t>::iterator;
+
+  static constexpr std::size_t NO_REGION = std::numeric_limits<std::size_t>::max();
+
+  const DomainModel &domainModel;
+  std::vector<std::vector<std::size_t>> regions;
+  std::vector<std::size_t> regionOfJunction;
+  // the region entered via each street, NO_REGION for streets within a region
+  std::vector<std::size_t> enteredRegionOfStreet;
+  // the length streets leaving a region are extended by at most, no car travels further in a simulation
+  double streetExtension = 0;
+  // the length of a stopped car and its gap to the car in front, at most
+  double maxStoppedCarSpacing = 0;
+
+  // the street each car was last seen on while recording the inflows and the step it was seen
+  std::vector<unsigned> lastStreetOfCar;
+  std::vector<unsigned> lastStepOfCar;
+
+  /**
+   * Splits the given junctions into 'regionCount' regions by recursive coordinate bisection, i.e. at the median of the
+   * coordinate with the larger extent. The number of junctions per region is balanced.
+   */
+  static void bisect(const DomainModel &model, JunctionIdIterator first, JunctionIdIterator last,
+      const unsigned regionCount, std::vector<std::vector<std::size_t>> &regions) {
+    if (first == last) { return; }
+    if (regionCount <= 1) {
+      regions.emplace_back(first, last);
+      return;
+    }
+
+    const auto &junctions = model.getJunctions();
+    int minX = junctions[*first].getX(), maxX = minX, minY = junctions[*first].getY(), maxY = minY;
+    for (auto it = first; it != last; ++it) {
+      minX = std::min(minX, junctions[*it].getX());
+      maxX = std::max(maxX, junctions[*it].getX());
+      minY = std::min(minY, junctions[*it].getY());
+      maxY = std::max(maxY, junctions[*it].getY());
+    }
+    const bool splitAlongX = (maxX - minX) >= (maxY - minY);
+
+    const unsigned firstRegionCount = regionCount / 2;
+    JunctionIdIterator middle       = first + (last - first) * firstRegionCount / regionCount;
+    std::nth_element(first, middle, last, [&](const std::size_t a, const std::size_t b) {
+      return splitAlongX ? junctions[a].getX() < junctions[b].getX() : junctions[a].getY() < junctions[b].getY();
+    });
+    bisect(model, first, middle, firstRegionCount, regions);
+    bisect(model, middle, last, regionCount - firstRegionCount, regions);
+  }
+
+  /** Returns the direction the given street is connected in, the street must be connected. */
+  template <typename ConnectedStreets>
+  static CardinalDirection getDirection(const ConnectedStreets &connectedStreets, const Street &street) {
+    for (const auto &connectedStreet : connectedStreets) {
+      if (connectedStreet.isConnected() && connectedStreet.getStreet()->getId() == street.getId()) {
+        return connectedStreet.getDirection();
+      }
+    }
+    throw std::invalid_argument("Street is not connected to junction!");
+  }
+
+  /** Returns a copy of the given car with another id, which has not traveled yet. */
+  static LowLevelCar renumberCar(const LowLevelCar &car, const unsigned id) {
+    LowLevelCar renumbered(id, car.getExternalId(), car.getTargetVelocity(), car.getMaxAcceleration(),
+        car.getAccelerationDivisor(), car.getMinDistance(), car.getTargetHeadway(), car.getPoliteness(),
+        car.getLength(), car.getLane(), car.getDistance(), car.getVelocity());
+    renumbered.setRouteIndex(car.getRouteIndex());
+    return renumbered;
+  }
+
+  /** Adds a copy of the vehicle of the given car to the model of a region, placed like the car on the given street. */
+  Vehicle &addVehicle(DomainModel &model, const LowLevelCar &car, Street &street) const {
+    const Vehicle &vehicle = domainModel.getVehicle(car.getId());
+    return model.addVehicle(Vehicle(0, vehicle.getExternalId(), vehicle.getTargetVelocity(),
+        vehicle.getMaxAcceleration(), vehicle.getTargetDeceleration(), vehicle.getMinDistance(),
+        vehicle.getTargetHeadway(), vehicle.getPoliteness(), vehicle.getRoute(),
+        Vehicle::Position(street, car.getLane(), car.getDistance())));
+  }
+
+public:
+  /**
+   * Partitions the junctions of the given domain model into regions.
+   * @param[in]  model               The domain model
+   * @param[in]  junctionsPerRegion  The targeted number of junctions per region
+   * @param[in]  stepCount           The number of steps the regions are simulated
+   */
+  RegionalDecomposition(const DomainModel &model, const unsigned junctionsPerRegion, const unsigned stepCount)
+      : domainModel(model), regionOfJunction(model.getJunctions().size()),
+        enteredRegionOfStreet(model.getStreets().size(), NO_REGION) {
+    std::vector<std::size_t> junctionIds(model.getJunctions().size());
+    for (std::size_t i = 0; i < junctionIds.size(); ++i) { junctionIds[i] = i; }
+    const unsigned regionCount = std::max<std::size_t>(1, junctionIds.size() / std::max(junctionsPerRegion, 1u));
+    bisect(model, junctionIds.begin(), junctionIds.end(), regionCount, regions);
+
+    for (std::size_t region = 0; region < regions.size(); ++region) {
+      for (std::size_t junctionId : regions[region]) { regionOfJunction[junctionId] = region; }
+    }
+    for (const auto &street : model.getStreets()) {
+      const std::size_t region = regionOfJunction[street.getTargetJunction().getId()];
+      if (regionOfJunction[street.getSourceJunction().getId()] != region) {
+        enteredRegionOfStreet[street.getId()] = region;
+      }
+    }
+
+    // a car starting at rest travels at most its maximum reachable velocity per step, see getMaxReachableVelocity()
+    double maxSpeedLimit = 0, maxVelocity = 0;
+    for (const auto &street : model.getStreets()) {
+      maxSpeedLimit = std::max(maxSpeedLimit, street.getSpeedLimit());
+    }
+    for (const auto &vehicle : model.getVehicles()) {
+      const double desiredVelocity = std::min(vehicle.getTargetVelocity(), maxSpeedLimit);
+      maxVelocity = std::max(maxVelocity, getMaxReachableVelocity(desiredVelocity, vehicle.getMaxAcceleration()));
+      maxStoppedCarSpacing = std::max(maxStoppedCarSpacing, VEHICLE_LENGTH + vehicle.getMinDistance());
+    }
+    streetExtension = (stepCount + 1) * maxVelocity;
+  }
+
+  std::size_t getRegionCount() const { return regions.size(); }
+  const std::vector<std::size_t> &getJunctionIds(const std::size_t region) const { return regions[region]; }
+
+  /**
+   * Prepares recording the inflows of a simulation of the whole model starting from the given low level model.
+   * @param[in]  initialLowLevel  The low level model the simulation starts from
+   * @param      inflows          Is cleared, see recordInflows()
+   */
+  void startRecording(const Snapshot &initialLowLevel, Inflows &inflows) {
+    lastStreetOfCar.assign(domainModel.getVehicles().size(), std::numeric_limits<unsigned>::max());
+    lastStepOfCar.assign(domainModel.getVehicles().size(), 0);
+    for (const auto &street : initialLowLevel.streets) {
+      for (const auto &car : street.allIterable()) { lastStreetOfCar[car.getId()] = street.getId(); }
+    }
+    inflows.assign(regions.size(), std::vector<BoundaryInflow>());
+  }
+
+  /**
+   * Appends the cars which entered a region in the last step of a simulation of the whole model to the inflows of the
+   * region. A car changes its street at most once per step, i.e. a car entered a street if it was not seen on it in
+   * the previous step.
+   * @param[in]  data     The simulation data of the simulation
+   * @param[in]  step     The number of steps performed so far
+   * @param      inflows  The inflows recorded so far
+   */
+  void recordInflows(const SimulationData<RfbStructure> &data, const unsigned step, Inflows &inflows) {
+    for (const auto &street : data.getStreets()) {
+      const std::size_t region = enteredRegionOfStreet[street.getId()];
+      if (region == NO_REGION) { continue; }
+      for (const auto &car : street.allIterable()) {
+        if (lastStreetOfCar[car.getId()] != street.getId() || lastStepOfCar[car.getId()] + 1 != step) {
+          inflows[region].push_back(BoundaryInflow{step, street.getId(), car});
+        }
+        lastStreetOfCar[car.getId()] = street.getId();
+        lastStepOfCar[car.getId()]   = step;
+      }
+    }
+  }
+
+  /**
+   * Builds the model of the neighbourhood of a region with the given signal plan. It contains the cars on the streets
+   * of the neighbourhood at the beginning and the cars entering it later.
+   * @param[in]  regionIndex      The region
+   * @param[in]  plan             The signal plan of the whole model
+   * @param[in]  initialLowLevel  The low level model of the whole model at the beginning of the simulation
+   * @param[in]  inflows          The inflows of the region recorded from a simulation starting at 'initialLowLevel'
+   * @param      region           Is set to the model of the region, must be newly constructed
+   */
+  void buildRegion(const std::size_t regionIndex, const SignalPlan &plan, const Snapshot &initialLowLevel,
+      const std::vector<BoundaryInflow> &inflows, Region &region) const {
+    region.junctionIds = regions[regionIndex];
+
+    std::vector<std::size_t> streetIds;
+    std::size_t initialCarCount = 0;
+    for (std::size_t junctionId : region.junctionIds) {
+      const Junction &junction = domainModel.getJunction(junctionId);
+      for (const auto &connectedStreet : junction.getIncomingStreets()) {
+        if (connectedStreet.isConnected()) { streetIds.push_back(connectedStreet.getStreet()->getId()); }
+      }
+      for (const auto &connectedStreet : junction.getOutgoingStreets()) {
+        if (connectedStreet.isConnected()) { streetIds.push_back(connectedStreet.getStreet()->getId()); }
+      }
+    }
+    std::sort(streetIds.begin(), streetIds.end());
+    streetIds.erase(std::unique(streetIds.begin(), streetIds.end()), streetIds.end());
+    for (std::size_t streetId : streetIds) { initialCarCount += initialLowLevel.streets[streetId].getCarCount(); }
+
+    // the junctions of the region come first, the junctions outside are added per street
+    DomainModel &model = region.model;
+    model.reserve(region.junctionIds.size() + streetIds.size(), streetIds.size(), initialCarCount + inflows.size());
+    std::vector<std::size_t> junctionInRegion(domainModel.getJunctions().size(), NO_REGION);
+    for (std::size_t junctionId : region.junctionIds) {
+      const Junction &junction     = domainModel.getJunction(junctionId);
+      junctionInRegion[junctionId] = model.getJunctions().size();
+      model.addJunction(Junction(0, junction.getExternalId(), junction.getX(), junction.getY(), plan[junctionId]));
+    }
+    // a junction outside has a single street, its only signal is for the unconnected opposite direction, i.e. the cars
+    // leaving the region stop at a red light
+    auto getJunction = [&](const Junction &junction, const CardinalDirection direction) -> Junction & {
+      const std::size_t junctionId = junctionInRegion[junction.getId()];
+      if (junctionId != NO_REGION) { return model.getJunction(junctionId); }
+      const std::vector<Junction::Signal> signals{Junction::Signal(CardinalDirection((direction + 2) % 4), 1)};
+      return model.addJunction(Junction(0, junction.getExternalId(), junction.getX(), junction.getY(), signals));
+    };
+    // the queue of all cars of the neighbourhood in a single lane fits onto the extension, twice their spacing
+    const double extension = std::min(
+        streetExtension, TRAFFIC_LIGHT_OFFSET + 2 * (initialCarCount + inflows.size()) * maxStoppedCarSpacing);
+
+    std::vector<std::size_t> streetInRegion(domainModel.getStreets().size(), NO_REGION);
+    for (std::size_t streetId : streetIds) {
+      const Street &street                = domainModel.getStreet(streetId);
+      const Junction &source              = street.getSourceJunction();
+      const Junction &target              = street.getTargetJunction();
+      const CardinalDirection outDirection = getDirection(source.getOutgoingStreets(), street);
+      const CardinalDirection inDirection  = getDirection(target.getIncomingStreets(), street);
+      Junction &from                      = getJunction(source, outDirection);
+      Junction &to                        = getJunction(target, inDirection);
+      const bool isLeaving                = junctionInRegion[target.getId()] == NO_REGION;
+      const double length                 = street.getLength() + (isLeaving ? extension : 0);
+      Street &added = model.addStreet(Street(0, street.getLanes(), street.getSpeedLimit(), length, from, to));
+      from.addOutgoingStreet(added, outDirection);
+      to.addIncomingStreet(added, inDirection);
+      streetInRegion[streetId] = added.getId();
+      region.streetLengths.push_back(street.getLength());
+    }
+
+    const LowLevelCar trafficLightCar(0, 0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0);
+    region.initialLowLevel.streets.reserve(streetIds.size());
+    for (const auto &street : model.getStreets()) {
+      region.initialLowLevel.streets.emplace_back(street.getId(), street.getLanes(), street.getLength(),
+          street.getSpeedLimit(), trafficLightCar, TRAFFIC_LIGHT_OFFSET);
+    }
+    for (std::size_t streetId : streetIds) {
+      Street &street = model.getStreet(streetInRegion[streetId]);
+      for (const auto &car : initialLowLevel.streets[streetId].allIterable()) {
+        const Vehicle &vehicle = addVehicle(model, car, street);
+        region.initialLowLevel.streets[street.getId()].insertCar(renumberCar(car, vehicle.getId()));
+      }
+    }
+    for (auto &street : region.initialLowLevel.streets) { street.incorporateInsertedCars(); }
+
+    region.inflows.reserve(inflows.size());
+    for (const auto &inflow : inflows) {
+      Street &street         = model.getStreet(streetInRegion[inflow.streetId]);
+      const Vehicle &vehicle = addVehicle(model, inflow.car, street);
+      region.inflows.push_back(BoundaryInflow{
+          inflow.step, static_cast<unsigned>(street.getId()), renumberCar(inflow.car, vehicle.getId())});
+    }
+    region.initialLowLevel.routingTable = std::make_shared<const RoutingTable>(model); // covers the inflowing cars
+  }
+
+  /**
+   * Performs 'stepCount' steps of a simulator of the neighbourhood of a region, which starts from the initial low level
+   * model of the region. The recorded cars are inserted after the step they entered the region in.
+   */
+  static void performSteps(const Region &region, SimulatorType &simulator, const unsigned stepCount) {
+    std::size_t nextInflow = 0;
+    simulator.performStepsUntil(stepCount, [&](const unsigned performedSteps) {
+      auto &streets = simulator.getData().getStreets();
+      for (; nextInflow < region.inflows.size() && region.inflows[nextInflow].step == performedSteps; ++nextInflow) {
+        streets[region.inflows[nextInflow].streetId].insertCar(region.inflows[nextInflow].car);
+      }
+      for (auto &street : streets) { street.incorporateInsertedCars(); }
+      return false;
+    });
+  }
+
+  /**
+   * Simulates the neighbourhood of a region with the signals currently set in its model for 'stepCount' steps.
+   * @return     The total travel distance of the cars within the neighbourhood, up to the original end of the streets
+   * leaving the region
+   */
+  static double simulateRegion(Region &region, const unsigned stepCount) {
+    region.model.resetModel();
+    SimulatorType simulator(region.model, region.initialLowLevel);
+    performSteps(region, simulator, stepCount);
+
+    double travelDistance = 0;
+    for (const auto &street : simulator.getData().getStreets()) {
+      const double length = region.streetLengths[street.getId()];
+      for (const auto &car : street.allIterable()) {
+        travelDistance += car.getTravelDistance() - std::max(0.0, car.getDistance() - length);
+      }
+    }
+    return travelDistance;
+  }
+
+  /** Copies the signals of the junctions of a region from a signal plan of its model to a plan of the whole model. */
+  static void mergeRegionPlan(const Region &region, const SignalPlan &regionPlan, SignalPlan &plan) {
+    for (std::size_t i = 0; i < region.junctionIds.size(); ++i) { plan[region.junctionIds[i]] = regionPlan[i]; }
+  }
+};
+
+#endif
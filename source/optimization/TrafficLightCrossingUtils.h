@@ -1,6 +1,7 @@
 #ifndef TRAFFIC_LIGHT_CROSSING_UTILS_H
 #define TRAFFIC_LIGHT_CROSSING_UTILS_H
 
+#include <cassert>
 #include <cmath>
 #include <vector>
 
@@ -14,148 +15,133 @@ struct TrafficLightCrossing {
 };
 
 /**
- * Evaluates a given order of traffic light durations at a junction based on the additive priority of the car crossing a
- * traffic light while it is green.
- *
- * Expects three vectors of the same length. The first, 'crossingsPerStreet', contains for each street of the junction
- * when and which car passed this streets traffic light. The second, 'trafficLightDuration', contains how long each
- * street's traffic light is green. The street order must be the same for both vectors. The third vector,
- * 'trafficLightOrder', represents the order of the traffic signals by giving the index of the corresponding street in
- * the first two vectors. Takes an optional function to assign a car a priority (by its id). Default: all cars have
- * priority 1.
- *
- * After evaluation the traffic light signals, their rating regarding different metrics such as the throughput at green
- * lights, the total throughput and the wait time can be retrieved with getter functions. These metrics can be accessed
- * streetwise and as a total for all streets of the junction, they can be weighted with the car priority using the
- * priority function given in the constructor.
+ * Iterable over a consecutive range of traffic light crossings, e.g. the crossings of a single street.
  */
-struct RateTrafficLights {
+struct TrafficLightCrossingRange {
 private:
-  const std::vector<std::vector<TrafficLightCrossing>> &crossingsPerStreet;
-  const std::vector<unsigned> &trafficLightDuration;
-  const std::vector<unsigned> &trafficLightOrder;
-  const std::vector<double> *carPriorities = 0;
-
-  unsigned streetCount;
-  unsigned totalDuration = 0;
-  std::vector<unsigned> initialOffset;
+  const TrafficLightCrossing *first;
+  const TrafficLightCrossing *last;
 
-  unsigned totalThroughputAtGreen;
-  std::vector<unsigned> throughputAtGreen;
-
-  double totalThroughputAtGreenWithPriority;
-  std::vector<double> throughputAtGreenWithPriority;
+public:
+  TrafficLightCrossingRange(const TrafficLightCrossing *first, const TrafficLightCrossing *last)
+      : first(first), last(last) {}
 
-  unsigned totalThroughput;
-  std::vector<unsigned> throughput;
+  const TrafficLightCrossing *begin() const { return first; }
+  const TrafficLightCrossing *end() const { return last; }
+  std::size_t size() const { return last - first; }
+  const TrafficLightCrossing &operator[](const std::size_t index) const { return first[index]; }
+};
 
-  double totalThroughputWithPriority;
-  std::vector<double> throughputWithPriority;
+/**
+ * Returns how long a car reaching a traffic light at 'currentTime' has to wait for the light to turn green. The traffic
+ * light is green for 'duration' seconds starting at 'offset' in each cycle of 'totalDuration' seconds.
+ */
+inline unsigned getTimeToNextGreen(
+    const unsigned currentTime, const unsigned offset, const unsigned duration, const unsigned totalDuration) {
+  assert(totalDuration != 0);
+  unsigned timeInFirstInterval = currentTime % totalDuration;
+  if (timeInFirstInterval < offset) { // traffic light was not yet green in the current cycle
+    return offset - timeInFirstInterval;
+  } else if (timeInFirstInterval < offset + duration) {
+    return 0; // traffic light is currently green
+  } else {    // traffic light was already green in the current cycle -> wait 'till the next cycle
+    return totalDuration - timeInFirstInterval + offset;
+  }
+}
 
-  unsigned totalWaitTime;
-  std::vector<unsigned> waitTime;
+/**
+ * Rates traffic lights of a junction for a fixed cycle length without iterating the crossings for every candidate.
+ *
+ * The crossings of each street are sorted by their time within the cycle (counting sort, as these times are bounded by
+ * the cycle length) and accumulated into prefix sums of their count, time, priority and priority weighted time. The
+ * wait time and throughput at green of a traffic light with any offset and duration in the cycle is then computed in
+ * constant time, e.g. when trying all signal orders for the same durations.
+ *
+ * Expects the crossings per street and the cycle length, i.e. the total duration of all signals. Takes optional car
+ * priorities (by car id). Default: all cars have priority 1.
+ */
+struct CycleTrafficLightRating {
+private:
+  unsigned streetCount;
+  unsigned cycleLength;
 
-  double totalWaitTimeWithPriority;
-  std::vector<double> waitTimeWithPriority;
+  // prefix sums per street, entry 'streetIndex * (cycleLength + 1) + t' accumulates all crossings before time t
+  std::vector<unsigned long long> crossingCount;
+  std::vector<unsigned long long> crossingTime;
+  std::vector<double> crossingPriority;
+  std::vector<double> crossingPriorityTime;
 
-  unsigned getTimeToNextGreen(const unsigned currentTime, const unsigned streetIndex) const {
-    assert(totalDuration != 0);
-    unsigned timeInFirstInterval = currentTime % totalDuration;
-    unsigned offset              = initialOffset[streetIndex];
-    if (timeInFirstInterval < offset) { // traffic light was not yet green in the current cycle
-      return offset - timeInFirstInterval;
-    } else if (timeInFirstInterval < offset + trafficLightDuration[streetIndex]) {
-      return 0; // traffic light is currently green
-    } else {    // traffic light was already green in the current cycle -> wait 'till the next cycle
-      return totalDuration - timeInFirstInterval + offset;
-    }
+  std::size_t getPrefixIndex(const unsigned streetIndex, const unsigned time) const {
+    return static_cast<std::size_t>(streetIndex) * (cycleLength + 1) + time;
   }
 
-public:
-  RateTrafficLights(const std::vector<std::vector<TrafficLightCrossing>> &_crossingsPerStreet,
-      const std::vector<unsigned> &_trafficLightDuration, const std::vector<unsigned> &_trafficLightOrder,
-      const std::vector<double> *_carPriorities)
-      : crossingsPerStreet(_crossingsPerStreet), trafficLightDuration(_trafficLightDuration),
-        trafficLightOrder(_trafficLightOrder), carPriorities(_carPriorities), streetCount(_trafficLightOrder.size()),
-        initialOffset(streetCount, 0), totalThroughputAtGreen(0), throughputAtGreen(streetCount, 0),
-        totalThroughputAtGreenWithPriority(0), throughputAtGreenWithPriority(streetCount, 0), totalThroughput(0),
-        throughput(streetCount, 0), totalThroughputWithPriority(0), throughputWithPriority(streetCount, 0),
-        totalWaitTime(0), waitTime(streetCount, 0), totalWaitTimeWithPriority(0), waitTimeWithPriority(streetCount, 0) {
-    totalDuration = 0;
-    for (unsigned streetIndex : trafficLightOrder) {
-      initialOffset[streetIndex] = totalDuration;
-      totalDuration += trafficLightDuration[streetIndex];
-    }
-    evaluate();
+  template <typename T>
+  T getSum(const std::vector<T> &prefixSum, const unsigned streetIndex, const unsigned from, const unsigned to) const {
+    return prefixSum[getPrefixIndex(streetIndex, to)] - prefixSum[getPrefixIndex(streetIndex, from)];
   }
 
-  void evaluate() {
-    // for each street and each car that crossed this streets traffic light
-    for (unsigned streetIndex = 0; streetIndex < crossingsPerStreet.size(); ++streetIndex) {
-      for (const TrafficLightCrossing crossing : crossingsPerStreet[streetIndex]) {
-        double carPriority       = (carPriorities == 0) ? 1 : carPriorities->operator[](crossing.carId);
-        unsigned currentWaitTime = getTimeToNextGreen(crossing.timeStep, streetIndex);
-
-        if (currentWaitTime == 0) {
-          throughputAtGreen[streetIndex] += 1;
-          throughputAtGreenWithPriority[streetIndex] += carPriority;
-          throughput[streetIndex] += 1;
-          throughputWithPriority[streetIndex] += carPriority;
-        } else {
-          throughput[streetIndex] += 1;
-          throughputWithPriority[streetIndex] += carPriority;
-          waitTime[streetIndex] += currentWaitTime;
-          waitTimeWithPriority[streetIndex] += currentWaitTime * carPriority;
-        }
-      }
-    }
-
-    // compute totals
+public:
+  CycleTrafficLightRating(const std::vector<TrafficLightCrossingRange> &crossingsPerStreet, const unsigned _cycleLength,
+      const std::vector<double> *carPriorities)
+      : streetCount(crossingsPerStreet.size()), cycleLength(_cycleLength),
+        crossingCount(streetCount * (cycleLength + 1), 0), crossingTime(streetCount * (cycleLength + 1), 0),
+        crossingPriority(streetCount * (cycleLength + 1), 0), crossingPriorityTime(streetCount * (cycleLength + 1), 0) {
+    assert(cycleLength != 0);
     for (unsigned streetIndex = 0; streetIndex < streetCount; ++streetIndex) {
-      totalThroughputAtGreen += throughputAtGreen[streetIndex];
-      totalThroughputAtGreenWithPriority += throughputAtGreenWithPriority[streetIndex];
-      totalThroughput += throughput[streetIndex];
-      totalThroughputWithPriority += throughputWithPriority[streetIndex];
-      totalWaitTime += waitTime[streetIndex];
-      totalWaitTimeWithPriority += waitTimeWithPriority[streetIndex];
+      // bucket the crossings by their time in the cycle, bucket t is stored at t + 1 for the exclusive prefix sums
+      for (const TrafficLightCrossing &crossing : crossingsPerStreet[streetIndex]) {
+        const unsigned time      = crossing.timeStep % cycleLength;
+        const double carPriority = (carPriorities == 0) ? 1 : carPriorities->operator[](crossing.carId);
+        const std::size_t i      = getPrefixIndex(streetIndex, time + 1);
+        crossingCount[i] += 1;
+        crossingTime[i] += time;
+        crossingPriority[i] += carPriority;
+        crossingPriorityTime[i] += carPriority * time;
+      }
+      for (unsigned time = 1; time <= cycleLength; ++time) {
+        const std::size_t i = getPrefixIndex(streetIndex, time);
+        crossingCount[i] += crossingCount[i - 1];
+        crossingTime[i] += crossingTime[i - 1];
+        crossingPriority[i] += crossingPriority[i - 1];
+        crossingPriorityTime[i] += crossingPriorityTime[i - 1];
+      }
     }
   }
 
-  void reset() {
-    totalThroughputAtGreen             = 0;
-    totalThroughputAtGreenWithPriority = 0;
-    totalThroughput                    = 0;
-    totalThroughputWithPriority        = 0;
-    totalWaitTime                      = 0;
-    totalWaitTimeWithPriority          = 0;
-
-    std::fill(throughputAtGreen.begin(), throughputAtGreen.end(), 0);
-    std::fill(throughputAtGreenWithPriority.begin(), throughputAtGreenWithPriority.end(), 0);
-    std::fill(throughput.begin(), throughput.end(), 0);
-    std::fill(throughputWithPriority.begin(), throughputWithPriority.end(), 0);
-    std::fill(waitTime.begin(), waitTime.end(), 0);
-    std::fill(waitTimeWithPriority.begin(), waitTimeWithPriority.end(), 0);
+  unsigned getCycleLength() const { return cycleLength; }
+
+  /**
+   * Total wait time of the cars crossing the street's traffic light if it is green for 'duration' seconds starting at
+   * 'offset' in each cycle. Cars before the green phase wait until 'offset', cars after it until the next cycle.
+   */
+  unsigned long long getWaitTime(const unsigned streetIndex, const unsigned offset, const unsigned duration) const {
+    assert(offset + duration <= cycleLength);
+    const unsigned greenEnd = offset + duration;
+    return getSum(crossingCount, streetIndex, 0, offset) * offset - getSum(crossingTime, streetIndex, 0, offset)
+           + getSum(crossingCount, streetIndex, greenEnd, cycleLength) * (cycleLength + offset)
+           - getSum(crossingTime, streetIndex, greenEnd, cycleLength);
   }
 
-  unsigned getTotalThroughputAtGreen() const { return totalThroughputAtGreen; }
-  unsigned getThroughputAtGreen(const unsigned streetIndex) const { return throughputAtGreen[streetIndex]; }
-
-  double getTotalThroughputAtGreenWithPriority() const { return totalThroughputAtGreenWithPriority; }
-  double getThroughputAtGreenWithPriority(const unsigned streetIndex) const {
-    return throughputAtGreenWithPriority[streetIndex];
+  double getWaitTimeWithPriority(const unsigned streetIndex, const unsigned offset, const unsigned duration) const {
+    assert(offset + duration <= cycleLength);
+    const unsigned greenEnd = offset + duration;
+    return getSum(crossingPriority, streetIndex, 0, offset) * offset
+           - getSum(crossingPriorityTime, streetIndex, 0, offset)
+           + getSum(crossingPriority, streetIndex, greenEnd, cycleLength) * (cycleLength + offset)
+           - getSum(crossingPriorityTime, streetIndex, greenEnd, cycleLength);
   }
 
-  unsigned getTotalThroughput() const { return totalThroughput; }
-  unsigned getThroughput(const unsigned streetIndex) const { return throughput[streetIndex]; }
-
-  double getTotalThroughputWithPriority() const { return totalThroughputWithPriority; }
-  double getThroughputWithPriority(const unsigned streetIndex) const { return throughputWithPriority[streetIndex]; }
-
-  unsigned getTotalWaitTime() const { return totalWaitTime; }
-  unsigned getWaitTime(const unsigned streetIndex) const { return waitTime[streetIndex]; }
+  unsigned long long getThroughputAtGreen(
+      const unsigned streetIndex, const unsigned offset, const unsigned duration) const {
+    assert(offset + duration <= cycleLength);
+    return getSum(crossingCount, streetIndex, offset, offset + duration);
+  }
 
-  double getTotalWaitTimeWithPriority() const { return totalWaitTimeWithPriority; }
-  double getWaitTimeWithPriority(const unsigned streetIndex) const { return waitTimeWithPriority[streetIndex]; }
+  double getThroughputAtGreenWithPriority(
+      const unsigned streetIndex, const unsigned offset, const unsigned duration) const {
+    assert(offset + duration <= cycleLength);
+    return getSum(crossingPriority, streetIndex, offset, offset + duration);
+  }
 };
 
 #endif
\ No newline at end of file
@@ -6,6 +6,19 @@
 #include "LowLevelCar.h"
 #include "LowLevelStreet.h"
 
+/**
+ * Returns an upper bound on the velocity a car starting at rest reaches with the acceleration of computeAcceleration()
+ * and the velocity update v' = max(v + a, 0), as long as its desired velocity min(target velocity, speed limit) does
+ * not exceed 'desiredVelocity'. The update overshoots the desired velocity if the maximum acceleration exceeds a
+ * quarter of it: v + a is maximal at v* = (v0^4 / (4 a_max))^(1/3), where it amounts to a_max + 3/4 v*. A car faster
+ * than its desired velocity, e.g. after entering a street with a lower speed limit, decelerates.
+ */
+inline double getMaxReachableVelocity(const double desiredVelocity, const double maxAcceleration) {
+  if (maxAcceleration <= desiredVelocity / 4) { return desiredVelocity; }
+  const double overshootVelocity = std::cbrt(std::pow(desiredVelocity, 4) / (4 * maxAcceleration));
+  return maxAcceleration + 0.75 * overshootVelocity;
+}
+
 template <template <typename Vehicle> typename RfbStructure>
 class AccelerationComputer {
   using car_iterator = typename LowLevelStreet<RfbStructure>::iterator;
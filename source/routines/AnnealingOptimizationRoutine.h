@@ -0,0 +1,27 @@
+#ifndef ANNEALING_OPTIMIZATION_ROUTINE_H
+#define ANNEALING_OPTIMIZATION_ROUTINE_H
+
+#include "AnnealingSignalPlanSearch.h"
+#include "SimulationData.h"
+
+/**
+ * Routine selecting the population based signal plan search of the Optimizer, see AnnealingSignalPlanSearch.
+ *
+ * The signal plans are not improved within a simulation. Instead, the Optimizer evaluates whole populations of plans
+ * concurrently and reports their travel distances to the search engine given by the 'SearchEngine' type.
+ *
+ * @tparam     RfbStructure  The underlying data structure of the low level street
+ */
+template <template <typename Vehicle> typename RfbStructure>
+class AnnealingOptimizationRoutine {
+public:
+  using SearchEngine = AnnealingSignalPlanSearch;
+
+  AnnealingOptimizationRoutine(SimulationData<RfbStructure> &) {}
+
+  void perform() {}
+
+  void improveTrafficLights() {}
+};
+
+#endif
@@ -5,6 +5,7 @@
 #include "LowLevelCar.h"
 #include "LowLevelStreet.h"
 #include "RfbStructure.h"
+#include "RoutingTable.h"
 #include "SimulationData.h"
 #include <algorithm>
 
@@ -21,33 +22,23 @@ public:
    * @brief      Ensures model consistency, updates cars that change streets (and their correlating street).
    */
   void perform() {
-    DomainModel &model = data.getDomainModel();
+    const RoutingTable &routingTable = data.getRoutingTable();
     for (auto &street : data.getStreets()) {
-      // access domain model information for the low level street:
-      Street &domStreet                 = model.getStreet(street.getId());
-      Junction &domJunction             = domStreet.getTargetJunction();
-      CardinalDirection originDirection = calculateOriginDirection(domJunction, domStreet);
       // update low level  cars and restore consistency:
       street.updateCarsAndRestoreConsistency();
       // for every low level car that changes streets:
       auto beyondsIterable = street.beyondsIterable();
       for (auto vehicleIt = beyondsIterable.begin(); vehicleIt != beyondsIterable.end(); ++vehicleIt) {
-        // get domain model car and desired/available domain model destination street:
-        Vehicle &domVehicle                    = model.getVehicle(vehicleIt->getId());
-        CardinalDirection destinationDirection = takeTurn(originDirection, domVehicle.getNextDirection());
-        while (!domJunction.getOutgoingStreet(destinationDirection).isConnected()) {
-          destinationDirection = CardinalDirection((destinationDirection + 1) % 4);
-        }
-        Street *domDestinationStreet = domJunction.getOutgoingStreet(destinationDirection).getStreet();
+        // Copy the vehicle and get the destination street according to its route:
+        LowLevelCar vehicle                          = *vehicleIt;
+        const RoutingTable::Destination &destination = routingTable.takeNextTurn(vehicle, street.getId());
 
-        // Copy the vehicle and adjust distance
-        LowLevelCar vehicle = *vehicleIt;
-        int newLane         = std::min(vehicle.getLane(), domDestinationStreet->getLanes() - 1);
+        // adjust distance
+        unsigned int newLane = std::min(vehicle.getLane(), destination.maxLane);
         vehicle.setNext(newLane, vehicle.getDistance() - street.getLength(), vehicle.getVelocity());
 
         // insert car on correlating low level destination street:
-        LowLevelStreet<RfbStructure> &destinationStreet = data.getStreet(domDestinationStreet->getId());
-        destinationStreet.insertCar(vehicle);
+        data.getStreets()[destination.street].insertCar(vehicle);
       }
       // remove all leaving cars from current street:
       street.removeBeyonds();
@@ -63,7 +54,7 @@ public:
    * @return     The direction where the car is going.
    */
   CardinalDirection takeTurn(CardinalDirection origin, TurnDirection turn) {
-    return (CardinalDirection)((origin + turn) % 4);
+    return RoutingTable::takeTurn(origin, turn);
   }
 
   /**
@@ -73,12 +64,7 @@ public:
    * @return     The origin cardinal direction related to the current junction.
    */
   CardinalDirection calculateOriginDirection(Junction &junction, Street &incomingStreet) {
-    for (const auto &connectedStreet : junction.getIncomingStreets()) {
-      if (connectedStreet.isConnected() && connectedStreet.getStreet()->getId() == incomingStreet.getId()) {
-        return connectedStreet.getDirection();
-      }
-    }
-    throw std::invalid_argument("Street is not connected to junction!");
+    return RoutingTable::calculateOriginDirection(junction, incomingStreet);
   }
 
   SimulationData<RfbStructure> &data;
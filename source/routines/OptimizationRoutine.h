@@ -1,6 +1,7 @@
 #ifndef OPTIMIZATION_ROUTINE_H
 #define OPTIMIZATION_ROUTINE_H
 
+#include <array>
 #include <vector>
 
 #include "DomainModel.h"
@@ -23,6 +24,8 @@
  * the domain model junctions to increase the total travel distance of all cars. May use information previously
  * collected by perform() during the simulation.
  * The OptimizationRoutine is reinitialized after each optimization cycle.
+ * Alternatively, a routine may define a nested 'SearchEngine' type (see AnnealingOptimizationRoutine). The Optimizer
+ * then lets the search engine propose populations of signal plans and evaluates them concurrently instead.
  */
 template <template <typename Vehicle> typename RfbStructure>
 class OptimizationRoutine {
@@ -31,8 +34,11 @@ class OptimizationRoutine {
 
 private:
   SimulationData<RfbStructure> &data;
-  // contains for each junction a vector of requested green light directions per time step
-  std::vector<std::vector<CardinalDirection>> requestedGreenLights;
+  // contains for each junction the number of time steps a green light was requested per direction
+  std::vector<std::array<unsigned, 4>> requestedGreenLights;
+  unsigned performedSteps = 0;
+  // potential travel distance of the cars in the traffic light zone of each street (by id) in the current step
+  std::vector<double> potentialTravelDistance;
   const double trafficLightZoneMultiplier = 10.0; // TODO choose parameters
   // Is multiplied with the speed limit to determine the size of the traffic light zone
 
@@ -67,14 +73,16 @@ private:
    * defined as the minimum of the target velocity, the speed limit and the contextual velocity of the car in front.
    * Computing the potential travel distance of a car can be simplified to max(actual velocity, contextual velocity).
    * The traffic light zone is defined by the isInTrafficLightZone() function.
-   * @param[in]  streetId   The street identifier
-   * @param[in]  <unnamed>  Trait to allow different implementations for different RfbStructures
+   * @param[in]  streetId            The street identifier
+   * @param      contextualVelocity  Buffer for the contextual velocity per lane, reused across calls
+   * @param[in]  <unnamed>           Trait to allow different implementations for different RfbStructures
    * @return     The potential travel distance of all cars within the traffic light zone on the given street.
    */
-  double determinePotentialTravelDistance(const unsigned streetId, rfbstructure_reversible_sorted_iterator_tag) const {
+  double determinePotentialTravelDistance(const unsigned streetId, std::vector<double> &contextualVelocity,
+      rfbstructure_reversible_sorted_iterator_tag) const {
     double potentialTravelDistance = 0;
     double speedLimit              = getStreet(streetId).getSpeedLimit();
-    std::vector<double> contextualVelocity(getStreet(streetId).getLanes(), speedLimit);
+    contextualVelocity.assign(getStreet(streetId).getLanes(), speedLimit);
 
     auto streetIterable = getLowLevelStreet(streetId).getUnderlyingDataStructure().allIterable();
     for (auto carIt = streetIterable.rbegin(); carIt != streetIterable.rend(); ++carIt) {
@@ -98,29 +106,31 @@ private:
    * As before, the potential travel distance of all cars within the traffic light zone on the given street is computed.
    * However, the contextual velocity is computed bucket-wise to avoid unnecessary sorting of the unsorted buckets.
    * @param[in]  streetId   The street identifier
+   * @param      <unnamed>  Buffer for the contextual velocity per lane, unused as there is one velocity per bucket
    * @param[in]  <unnamed>  Trait to allow different implementations for different RfbStructures
    * @return     The potential travel distance of all cars within the traffic light zone on the given street.
    */
-  double determinePotentialTravelDistance(const unsigned streetId, rfbstructure_buckets_tag) const {
+  double determinePotentialTravelDistance(
+      const unsigned streetId, std::vector<double> &, rfbstructure_buckets_tag) const {
     double potentialTravelDistance = 0;
     const double speedLimit        = getStreet(streetId).getSpeedLimit();
 
-    auto rfb = getLowLevelStreet(streetId).getUnderlyingDataStructure();
+    const auto &rfb = getLowLevelStreet(streetId).getUnderlyingDataStructure();
     for (unsigned lane = 0; lane < getStreet(streetId).getLanes(); ++lane) { // for each lane
       double contextualVelocity = speedLimit;
       double currentDistance    = getLowLevelStreet(streetId).getLength();
       // for each section, i.e. each bucket in the current lane
       for (int section = rfb.getSectionCount() - 1; section >= 0; --section) {
-        auto bucket = rfb.getBucket(section, lane); // retrieve the current bucket
+        const auto &bucket = rfb.getBucket(section, lane); // retrieve the current bucket
 
         // stop once the end of the traffic light zone is reached, i.e. the bucket does not overlap with the zone
         currentDistance -= rfb.getSectionLength();
         if (!isInTrafficLightZone(currentDistance, streetId)) { break; }
 
         // compute bucket wise contextual velocity
-        for (auto car : bucket) { contextualVelocity = std::min(contextualVelocity, car.getTargetVelocity()); }
+        for (const auto &car : bucket) { contextualVelocity = std::min(contextualVelocity, car.getTargetVelocity()); }
         // compute potential travel distance in the current step and bucket
-        for (auto car : bucket) {
+        for (const auto &car : bucket) {
           double actualVelocity = car.getNextVelocity();
           potentialTravelDistance += std::max(actualVelocity, contextualVelocity);
         }
@@ -131,6 +141,7 @@ private:
 
   /**
    * Determines the optimal green light for a given junction in the current step based o the potential travel distance.
+   * Expects the potential travel distance of all streets to be determined for the current step.
    * @param[in]  junction  The junction
    * @return     The direction of the incoming street with maximal potential travel distance.
    */
@@ -139,10 +150,9 @@ private:
     CardinalDirection requestedDirection = NORTH;
     for (const auto &street : junction.getIncomingStreets()) {
       if (!street.isConnected()) { continue; } // skip non-existent streets
-      double potentialTravelDistance =
-          determinePotentialTravelDistance(street.getStreet()->getId(), reverse_category());
-      if (potentialTravelDistance > maxPotentialTravelDistance) {
-        maxPotentialTravelDistance = potentialTravelDistance;
+      double streetPotentialTravelDistance = potentialTravelDistance[street.getStreet()->getId()];
+      if (streetPotentialTravelDistance > maxPotentialTravelDistance) {
+        maxPotentialTravelDistance = streetPotentialTravelDistance;
         requestedDirection         = street.getDirection();
       }
     }
@@ -151,18 +161,41 @@ private:
 
 public:
   OptimizationRoutine(SimulationData<RfbStructure> &_data)
-      : data(_data), requestedGreenLights(data.getDomainModel().getJunctions().size()) {}
+      : data(_data), requestedGreenLights(data.getDomainModel().getJunctions().size(), std::array<unsigned, 4>{}),
+        potentialTravelDistance(data.getDomainModel().getStreets().size(), 0) {}
 
   /**
    * Determine the optimal green light direction for each junction in the current step.
-   * Insert these directions into the requestedGreenLights vector.
+   * Count these directions in the requestedGreenLights vector.
+   * The potential travel distance of each street is determined once in a street-parallel pass, as every street is the
+   * incoming street of exactly one junction.
    */
   void perform() {
-    for (auto const &junction : data.getDomainModel().getJunctions()) {
-      requestedGreenLights[junction->getId()].push_back(determineOptimalGreenLight(*junction));
+    const auto &junctions = data.getDomainModel().getJunctions();
+#pragma omp parallel shared(junctions)
+    {
+      std::vector<double> contextualVelocity; // per thread buffer
+#pragma omp for schedule(static)
+      for (std::size_t streetId = 0; streetId < potentialTravelDistance.size(); ++streetId) {
+        potentialTravelDistance[streetId] =
+            determinePotentialTravelDistance(streetId, contextualVelocity, reverse_category());
+      }
+#pragma omp for schedule(static)
+      for (std::size_t i = 0; i < junctions.size(); ++i) {
+        ++requestedGreenLights[junctions[i].getId()][determineOptimalGreenLight(junctions[i])];
+      }
     }
+    ++performedSteps;
   }
 
+  /** The potential travel distance of the cars in the traffic light zone of the given street in the last step. */
+  double getPotentialTravelDistance(const unsigned streetId) const { return potentialTravelDistance[streetId]; }
+  /** The number of steps a green light was requested for each direction of the given junction. */
+  const std::array<unsigned, 4> &getRequestedGreenLights(const unsigned junctionId) const {
+    return requestedGreenLights[junctionId];
+  }
+  unsigned getPerformedSteps() const { return performedSteps; }
+
   /**
    * Improves the traffic light durations base on the observations made during the last simulation.
    * Retrieves the requested green lights from the OptimizationRoutine sets the new signal durations as mean of the
@@ -170,16 +203,19 @@ public:
    * defined in 'relativeRescaleDurationLimit' the total duration of that junction is increased.
    */
   void improveTrafficLights() {
-    for (auto const &junction : data.getDomainModel().getJunctions()) {
-      const std::vector<CardinalDirection> &requestedGreenLightDirection = requestedGreenLights[junction->getId()];
+    for (auto &junction : data.getDomainModel().getJunctions()) {
+      const std::array<unsigned, 4> &requestedGreenLightCount = requestedGreenLights[junction.getId()];
 
       // Determine percentage of green light requests per direction
       std::vector<double> requestPercentage(4, 0);
-      for (auto direction : requestedGreenLightDirection) { ++requestPercentage[direction]; }
-      for (unsigned i = 0; i < 4; ++i) { requestPercentage[i] /= requestedGreenLightDirection.size(); }
+      if (performedSteps > 0) {
+        for (unsigned i = 0; i < 4; ++i) {
+          requestPercentage[i] = static_cast<double>(requestedGreenLightCount[i]) / performedSteps;
+        }
+      }
 
       // Get the old signals and determine their total duration
-      std::vector<Junction::Signal> oldSignals = junction->getSignals();
+      std::vector<Junction::Signal> oldSignals = junction.getSignals();
       std::vector<unsigned> signalDurations;
       double totalSignalsDuration = 0;
       for (const auto signal : oldSignals) { totalSignalsDuration += signal.getDuration(); }
@@ -212,7 +248,7 @@ public:
         newSignals[i] = Junction::Signal(oldSignals[i].getDirection(), signalDurations[i]);
       }
 
-      junction->setSignals(newSignals);
+      junction.setSignals(newSignals);
     }
   }
 };
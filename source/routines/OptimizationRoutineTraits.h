@@ -0,0 +1,32 @@
+#ifndef OPTIMIZATION_ROUTINE_TRAITS
+#define OPTIMIZATION_ROUTINE_TRAITS
+
+#include <type_traits>
+
+struct optimizationroutine_cycle_tag {};
+struct optimizationroutine_search_engine_tag {};
+struct optimizationroutine_region_tag {};
+
+/**
+ * Distinguishes optimization routines improving the signal plan once per optimization cycle from routines delegating
+ * to a population based search engine, which is given by a nested 'SearchEngine' type, and from routines searching the
+ * signal plans of regions of junctions independently, whose search engine is given by a nested 'RegionSearchEngine'.
+ */
+template <typename OptimizationRoutine, typename = void>
+struct optimizationroutine_traits {
+  using optimization_category = optimizationroutine_cycle_tag;
+};
+
+template <typename OptimizationRoutine>
+struct optimizationroutine_traits<OptimizationRoutine, std::void_t<typename OptimizationRoutine::SearchEngine>> {
+  using optimization_category = optimizationroutine_search_engine_tag;
+  using SearchEngine          = typename OptimizationRoutine::SearchEngine;
+};
+
+template <typename OptimizationRoutine>
+struct optimizationroutine_traits<OptimizationRoutine, std::void_t<typename OptimizationRoutine::RegionSearchEngine>> {
+  using optimization_category = optimizationroutine_region_tag;
+  using SearchEngine          = typename OptimizationRoutine::RegionSearchEngine;
+};
+
+#endif
@@ -4,9 +4,10 @@
 #include "DomainModel.h"
 #include "LowLevelCar.h"
 #include "LowLevelStreet.h"
+#include "Profiler.h"
 #include "RfbStructure.h"
+#include "RoutingTable.h"
 #include "SimulationData.h"
-#include "Timer.h"
 #include <algorithm>
 #ifdef OMP
 #include <omp.h>
@@ -24,21 +25,18 @@ public:
    * @brief      Ensures model consistency, updates cars that change streets (and their correlating street).
    */
   void perform() {
-#ifdef TIMER
-    consistencyRoutine_restoreConsistency_timer.start();
-    restoreConsistency(); // street-wise parallel
-    consistencyRoutine_restoreConsistency_timer.stop();
-    consistencyRoutine_relocateCars_timer.start();
-    relocateCars(); // sequential
-    consistencyRoutine_relocateCars_timer.stop();
-    consistencyRoutine_incorporateCars_timer.start();
-    incorporateCars(); // street-wise parallel
-    consistencyRoutine_incorporateCars_timer.stop();
-#else
-    restoreConsistency(); // street-wise parallel
-    relocateCars();       // sequential
-    incorporateCars();    // street-wise parallel
-#endif
+    {
+      Profiler::Zone zone("consistencyRoutine_restoreConsistency");
+      restoreConsistency(); // street-wise parallel
+    }
+    {
+      Profiler::Zone zone("consistencyRoutine_relocateCars");
+      relocateCars(); // sequential
+    }
+    {
+      Profiler::Zone zone("consistencyRoutine_incorporateCars");
+      incorporateCars(); // street-wise parallel
+    }
   }
 
   /**
@@ -47,6 +45,7 @@ public:
   void restoreConsistency() {
 #pragma omp parallel for shared(data) schedule(static)
     for (std::size_t i = 0; i < data.getStreets().size(); i++) {
+      Profiler::Zone zone("restoreConsistency_street", Profiler::STREETS, i);
       auto &street = data.getStreets()[i];
       street.updateCarsAndRestoreConsistency();
     }
@@ -56,17 +55,13 @@ public:
    * @brief      2. Relocate the cars that change streets to the right streets and lanes.
    */
   void relocateCars() {
-    DomainModel &model = data.getDomainModel();
+    const RoutingTable &routingTable = data.getRoutingTable();
     for (auto &street : data.getStreets()) {
-      // access domain model information for the low level street:
-      Street &domStreet                 = model.getStreet(street.getId());
-      Junction &domJunction             = domStreet.getTargetJunction();
-      CardinalDirection originDirection = calculateOriginDirection(domJunction, domStreet);
       // for every low level car that changes streets:
       auto beyondsIterable = street.beyondsIterable();
       for (auto vehicleIt = beyondsIterable.begin(); vehicleIt != beyondsIterable.end(); ++vehicleIt) {
         LowLevelCar &vehicle = *vehicleIt;
-        relocateCar(vehicle, street, domJunction, originDirection);
+        relocateCar(vehicle, street, routingTable);
       }
       // remove all leaving cars from current street:
       street.removeBeyonds();
@@ -79,6 +74,7 @@ public:
   void incorporateCars() {
 #pragma omp parallel for shared(data) schedule(static)
     for (std::size_t i = 0; i < data.getStreets().size(); i++) {
+      Profiler::Zone zone("incorporateCars_street", Profiler::STREETS, i);
       auto &street = data.getStreets()[i];
       street.incorporateInsertedCars();
     }
@@ -86,27 +82,18 @@ public:
 
   /**
    * @brief      Relocates a single car that change streets.
-   * @param      vehicle          The vehicle iterator, which points to the car.
-   * @param      street           The street where the car is coming from.
-   * @param      domJunction      The junction where the car changes streets.
-   * @param[in]  originDirection  The origin direction from where the car is coming from.
+   * @param      vehicle       The vehicle iterator, which points to the car.
+   * @param      street        The street where the car is coming from.
+   * @param      routingTable  The routing table determining the destination street of the car.
    */
-  void relocateCar(LowLevelCar &vehicle, LowLevelStreet<RfbStructure> &street, Junction &domJunction,
-      CardinalDirection originDirection) {
-    DomainModel &model = data.getDomainModel();
-    // get domain model car and desired/available domain model destination street:
-    Vehicle &domVehicle                    = model.getVehicle(vehicle.getId());
-    CardinalDirection destinationDirection = takeTurn(originDirection, domVehicle.getNextDirection());
-    while (!domJunction.getOutgoingStreet(destinationDirection).isConnected()) {
-      destinationDirection = CardinalDirection((destinationDirection + 1) % 4);
-    }
-    Street *domDestinationStreet = domJunction.getOutgoingStreet(destinationDirection).getStreet();
+  void relocateCar(LowLevelCar &vehicle, LowLevelStreet<RfbStructure> &street, const RoutingTable &routingTable) {
+    // get the destination street according to the route of the car:
+    const RoutingTable::Destination &destination = routingTable.takeNextTurn(vehicle, street.getId());
     // Copy the vehicle and adjust distance:
-    int newLane = std::min(vehicle.getLane(), domDestinationStreet->getLanes() - 1);
+    unsigned int newLane = std::min(vehicle.getLane(), destination.maxLane);
     vehicle.setNext(newLane, vehicle.getDistance() - street.getLength(), vehicle.getVelocity());
     // insert car on correlating low level destination street:
-    LowLevelStreet<RfbStructure> &destinationStreet = data.getStreet(domDestinationStreet->getId());
-    destinationStreet.insertCar(vehicle);
+    data.getStreets()[destination.street].insertCar(vehicle);
   }
 
   /**
@@ -116,7 +103,7 @@ public:
    * @return     The direction where the car is going.
    */
   CardinalDirection takeTurn(CardinalDirection origin, TurnDirection turn) {
-    return (CardinalDirection)((origin + turn) % 4);
+    return RoutingTable::takeTurn(origin, turn);
   }
 
   /**
@@ -126,12 +113,7 @@ public:
    * @return     The origin cardinal direction related to the current junction.
    */
   CardinalDirection calculateOriginDirection(Junction &junction, Street &incomingStreet) {
-    for (const auto &connectedStreet : junction.getIncomingStreets()) {
-      if (connectedStreet.isConnected() && connectedStreet.getStreet()->getId() == incomingStreet.getId()) {
-        return connectedStreet.getDirection();
-      }
-    }
-    throw std::invalid_argument("Street is not connected to junction!");
+    return RoutingTable::calculateOriginDirection(junction, incomingStreet);
   }
 
   SimulationData<RfbStructure> &data;
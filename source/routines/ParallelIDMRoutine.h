@@ -12,8 +12,8 @@
 #include "AccelerationComputer.h"
 #include "LowLevelCar.h"
 #include "LowLevelStreet.h"
+#include "Profiler.h"
 #include "SimulationData.h"
-#include "Timer.h"
 
 template <template <typename Vehicle> typename RfbStructure>
 class ParallelIDMRoutine {
@@ -42,30 +42,25 @@ private:
 public:
   ParallelIDMRoutine(SimulationData<RfbStructure> &_data) : data(_data) {}
   void perform() {
-#ifdef TIMER
-    IDMRoutine_thresholdSorting_timer.start();
-#endif
-    for (auto &street : data.getStreets()) {
-      unsigned int carCount = street.getCarCount();
-      if (carCount > PARALLEL_THRESHOLD) {
-        carWise.push_back(street.getId());
-      } else if (carCount > 0) { // only push non-empty streets
-        streetWise.push_back(street.getId());
+    {
+      Profiler::Zone zone("IDMRoutine_thresholdSorting");
+      for (auto &street : data.getStreets()) {
+        unsigned int carCount = street.getCarCount();
+        if (carCount > PARALLEL_THRESHOLD) {
+          carWise.push_back(street.getId());
+        } else if (carCount > 0) { // only push non-empty streets
+          streetWise.push_back(street.getId());
+        }
       }
     }
-
-#ifdef TIMER
-    IDMRoutine_thresholdSorting_timer.stop();
-    IDMRoutine_performStreetWise_timer.start();
-    performStreetWise(streetWise);
-    IDMRoutine_performStreetWise_timer.stop();
-    IDMRoutine_performCarWise_timer.start();
-    performCarWise(carWise);
-    IDMRoutine_performCarWise_timer.stop();
-#else
-    performStreetWise(streetWise);
-    performCarWise(carWise);
-#endif
+    {
+      Profiler::Zone zone("IDMRoutine_performStreetWise");
+      performStreetWise(streetWise);
+    }
+    {
+      Profiler::Zone zone("IDMRoutine_performCarWise");
+      performCarWise(carWise);
+    }
 
     carWise.clear();
     streetWise.clear();
@@ -75,6 +70,7 @@ private:
   void performStreetWise(std::vector<unsigned int> &streetIds) {
 #pragma omp parallel for shared(data) schedule(static)
     for (std::size_t i = 0; i < streetIds.size(); i++) {
+      Profiler::Zone zone("performStreetWise_street", Profiler::STREETS, streetIds[i]);
       // get the right street
       auto &street = data.getStreet(streetIds[i]);
       // Initialise acceleration computer for use during computation
@@ -92,6 +88,7 @@ private:
 
   void performCarWise(std::vector<unsigned int> &streetIds) {
     for (auto streetId : streetIds) {
+      Profiler::Zone zone("performCarWise_street", Profiler::STREETS, streetId);
       auto &street = data.getStreet(streetId);
       // Initialise acceleration computer for use during computation
       AccelerationComputerRfb accelerationComputer(street);
@@ -31,7 +31,7 @@ public:
    */
   void perform() {
     DomainModel &model    = data.getDomainModel();
-    const auto &junctions = model.getJunctions();
+    auto &junctions       = model.getJunctions();
     if (junctions.size() > PARALLEL_THRESHOLD) {
       performParallel(junctions);
     } else {
@@ -39,16 +39,15 @@ public:
     }
   }
 
-  void performParallel(const std::vector<std::unique_ptr<Junction>> &junctions) {
+  void performParallel(ElementStorage<Junction> &junctions) {
 #pragma omp parallel for shared(junctions) schedule(static)
     for (std::size_t i = 0; i < junctions.size(); i++) {
-      const auto &junction = junctions[i];
-      perform(*junction);
+      perform(junctions[i]);
     }
   }
 
-  void performSequential(const std::vector<std::unique_ptr<Junction>> &junctions) {
-    for (auto const &junction : junctions) { perform(*junction); }
+  void performSequential(ElementStorage<Junction> &junctions) {
+    for (auto &junction : junctions) { perform(junction); }
   }
 
   void perform(Junction &junction) {
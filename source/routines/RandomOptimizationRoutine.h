@@ -29,16 +29,16 @@ public:
   void improveTrafficLights() {
     std::vector<Junction::Signal> newSignals;
 
-    // Initialize random engine from clock.
+    // Initialize random engine from clock, mixed with a random device to decorrelate concurrently optimized candidates.
     std::default_random_engine rng;
     rng.seed(static_cast<std::default_random_engine::result_type>(
-        std::chrono::system_clock::now().time_since_epoch().count()));
+        std::chrono::system_clock::now().time_since_epoch().count() ^ std::random_device()()));
 
     std::uniform_int_distribution<unsigned int> dist(5, 20);
 
-    for (auto const &junction : data.getDomainModel().getJunctions()) {
+    for (auto &junction : data.getDomainModel().getJunctions()) {
 
-      for (const auto &incomingStreet : junction->getIncomingStreets()) {
+      for (const auto &incomingStreet : junction.getIncomingStreets()) {
         if (incomingStreet.isConnected()) {
           // Draw random signalDuration for each connected street
           unsigned int signalDuration = dist(rng);
@@ -49,7 +49,7 @@ public:
       // Shuffle signals (permutation)
       std::shuffle(newSignals.begin(), newSignals.end(), rng);
 
-      junction->setSignals(std::move(newSignals));
+      junction.setSignals(std::move(newSignals));
       newSignals.clear();
     }
   }
@@ -0,0 +1,32 @@
+#ifndef REGIONAL_OPTIMIZATION_ROUTINE_H
+#define REGIONAL_OPTIMIZATION_ROUTINE_H
+
+#include "AnnealingSignalPlanSearch.h"
+#include "SimulationData.h"
+
+/**
+ * Routine selecting the region decomposed optimization of the Optimizer, see RegionalDecomposition.
+ *
+ * The junctions are partitioned into regions of 'junctionsPerRegion' junctions. In each optimization cycle, the signal
+ * plan of each region is searched by a search engine of the 'RegionSearchEngine' type for 'generationsPerCycle'
+ * generations of 'populationSize' plans, which are evaluated by simulating the neighbourhood of the region only.
+ *
+ * @tparam     RfbStructure  The underlying data structure of the low level street
+ */
+template <template <typename Vehicle> typename RfbStructure>
+class RegionalOptimizationRoutine {
+public:
+  using RegionSearchEngine = AnnealingSignalPlanSearch;
+
+  static constexpr unsigned junctionsPerRegion  = 4;
+  static constexpr unsigned generationsPerCycle = 4;
+  static constexpr unsigned populationSize      = 2;
+
+  RegionalOptimizationRoutine(SimulationData<RfbStructure> &) {}
+
+  void perform() {}
+
+  void improveTrafficLights() {}
+};
+
+#endif
@@ -23,22 +23,22 @@ public:
   void perform() {
     DomainModel &model = data.getDomainModel();
     if (model.isGreenWave()) { // debug mode
-      for (auto const &junction : model.getJunctions()) {
-        junction->nextStep();                              // simulate step anyway
-        for (auto const signal : junction->getSignals()) { // set all signals green:
-          setStreetForSignal(Signal::GREEN, signal, *junction);
+      for (auto &junction : model.getJunctions()) {
+        junction.nextStep();                              // simulate step anyway
+        for (auto const signal : junction.getSignals()) { // set all signals green:
+          setStreetForSignal(Signal::GREEN, signal, junction);
         }
       }
     } else {
-      for (auto const &junction : model.getJunctions()) {
-        bool lightChanged = junction->nextStep();
+      for (auto &junction : model.getJunctions()) {
+        bool lightChanged = junction.nextStep();
         if (lightChanged) {
           // Turn previous red:
-          Junction::Signal previous = junction->getPreviousSignal();
-          toggleStreetForSignal(previous, *junction);
+          Junction::Signal previous = junction.getPreviousSignal();
+          toggleStreetForSignal(previous, junction);
           // Turn current green:
-          Junction::Signal current = junction->getCurrentSignal();
-          toggleStreetForSignal(current, *junction);
+          Junction::Signal current = junction.getCurrentSignal();
+          toggleStreetForSignal(current, junction);
         }
       }
     }
@@ -42,14 +42,71 @@ void resetAllVehiclesTest() {
     model.addVehicle(vehicle);
   }
   // change and verify position of every single one:
-  for (auto const &vehicle : model.getVehicles()) {
-    Vehicle::Position position = vehicle->getPosition();
-    vehicle->setPosition(*position.getStreet(), 0, 44.4);
-    AssertThat(vehicle->getPosition().getDistance(), Is().EqualTo(44.4));
+  for (auto &vehicle : model.getVehicles()) {
+    Vehicle::Position position = vehicle.getPosition();
+    vehicle.setPosition(*position.getStreet(), 0, 44.4);
+    AssertThat(vehicle.getPosition().getDistance(), Is().EqualTo(44.4));
   }
   // reset to starting point and verify:
   model.resetModel();
   for (auto const &vehicle : model.getVehicles()) {
-    AssertThat(vehicle->getPosition().getDistance(), Is().EqualTo(33.3));
+    AssertThat(vehicle.getPosition().getDistance(), Is().EqualTo(33.3));
   }
-}
\ No newline at end of file
+}
+void copyModelTest() {
+  DomainModel model = DomainModel();
+  // create two connected junctions with a street in each direction and a vehicle on the first street:
+  Junction &first   = model.addJunction(createTestJunction());
+  Junction &second  = model.addJunction(createTestJunction());
+  Street &there     = model.addStreet(Street(0, 1, 50.0, 100.0, first, second));
+  Street &back      = model.addStreet(Street(0, 1, 50.0, 100.0, second, first));
+  first.addOutgoingStreet(there, CardinalDirection::EAST);
+  second.addIncomingStreet(there, CardinalDirection::WEST);
+  second.addOutgoingStreet(back, CardinalDirection::WEST);
+  first.addIncomingStreet(back, CardinalDirection::EAST);
+  const std::vector<TurnDirection> route{TurnDirection::UTURN, TurnDirection::STRAIGHT};
+  Vehicle &vehicle = model.addVehicle(Vehicle(0, 0, 45.0, 1.0, 1.0, 10.0, 5.0, 0.5, route, {there, 0, 33.3}));
+  vehicle.setPosition(back, 0, 44.4);
+  vehicle.getNextDirection();
+  first.nextStep();
+  // copy and verify that the copy refers to its own elements only:
+  DomainModel copy(model);
+  Junction &copiedFirst = copy.getJunction(first.getId());
+  AssertThat(&copiedFirst, Is().Not().EqualTo(&first));
+  AssertThat(&copy.getStreet(there.getId()).getTargetJunction(), Is().EqualTo(&copy.getJunction(second.getId())));
+  AssertThat(copiedFirst.getOutgoingStreet(CardinalDirection::EAST).getStreet(), Is().EqualTo(&copy.getStreet(0)));
+  AssertThat(copiedFirst.getIncomingStreet(CardinalDirection::EAST).getStreet(), Is().EqualTo(&copy.getStreet(1)));
+  // verify that the state is copied:
+  Vehicle &copiedVehicle = copy.getVehicle(vehicle.getId());
+  AssertThat(copiedVehicle.getPosition().getStreet(), Is().EqualTo(&copy.getStreet(1)));
+  AssertThat(copiedVehicle.getPosition().getDistance(), Is().EqualTo(44.4));
+  AssertThat(copiedVehicle.getNextDirection(), Is().EqualTo(TurnDirection::STRAIGHT));
+  copiedVehicle.resetPosition();
+  AssertThat(copiedVehicle.getPosition().getStreet(), Is().EqualTo(&copy.getStreet(0)));
+  AssertThat(vehicle.getPosition().getStreet(), Is().EqualTo(&back));
+  for (int i = 0; i < 9; ++i) { AssertThat(copiedFirst.nextStep(), Is().EqualTo(first.nextStep())); }
+}
+
+/*
+ * Tests if elements keep their address and id when more elements are added than reserved.
+ */
+void elementStorageTest() {
+  DomainModel model = DomainModel();
+  model.reserve(0, 1, 10);
+  Street &street = model.addStreet(createTestStreet());
+  const std::vector<TurnDirection> route{TurnDirection::STRAIGHT};
+  Vehicle &first = model.addVehicle(Vehicle(0, 0, 45.0, 1.0, 1.0, 10.0, 5.0, 0.5, route, {street, 0, 33.3}));
+  for (int i = 1; i < 3000; ++i) {
+    model.addVehicle(Vehicle(0, i, 45.0, 1.0, 1.0, 10.0, 5.0, 0.5, route, {street, 0, 33.3}));
+  }
+  AssertThat(&model.getVehicle(0), Is().EqualTo(&first));
+  AssertThat(model.getVehicles().size(), Is().EqualTo((unsigned int)3000));
+  id_type expectedId = 0;
+  for (const auto &vehicle : model.getVehicles()) {
+    AssertThat(vehicle.getId(), Is().EqualTo(expectedId));
+    AssertThat(vehicle.getExternalId(), Is().EqualTo((int)expectedId));
+    AssertThat(&model.getVehicles()[expectedId], Is().EqualTo(&vehicle));
+    ++expectedId;
+  }
+  AssertThrows(std::out_of_range, model.getVehicle(3000));
+}
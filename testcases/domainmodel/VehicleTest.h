@@ -36,4 +36,16 @@ void setPositionTest() {
   // reset position to original state
   vehicle.resetPosition();
   AssertThat(position.getDistance(), Is().EqualTo(33.3));
-}
\ No newline at end of file
+}
+/*
+ * Tests if the unchecked position update sets the position and the route index.
+ */
+void updatePositionTest() {
+  Street street = createTestStreet();
+  const std::vector<TurnDirection> route{TurnDirection::STRAIGHT, TurnDirection::LEFT};
+  Vehicle vehicle(0, 0, 45.0, 1.0, 1.0, 10.0, 5.0, 0.5, route, Vehicle::Position(street, 0, 33.3));
+  vehicle.updatePosition(street, 1, 44.4, 1);
+  AssertThat(vehicle.getPosition().getLane(), Is().EqualTo(1u));
+  AssertThat(vehicle.getPosition().getDistance(), Is().EqualTo(44.4));
+  AssertThat(vehicle.getDirectionIndex(), Is().EqualTo(1));
+}
@@ -0,0 +1,198 @@
+#ifndef BINARY_SCENARIO_READER_TEST_H
+#define BINARY_SCENARIO_READER_TEST_H
+
+#include "BinaryScenarioFormat.h"
+#include "BinaryScenarioReader.h"
+#include "BinaryScenarioWriter.h"
+#include "DomainModel.h"
+#include "JSONReader.h"
+#include <../../snowhouse/snowhouse.h>
+
+#include <cstddef>
+#include <cstring>
+#include <sstream>
+#include <string>
+
+using namespace snowhouse;
+
+/** Reads a scenario of three junctions and two roads with two cars from JSON and writes it in the binary format. */
+std::string writeBinaryTestScenario(DomainModel &model) {
+  std::istringstream in("{\"time_steps\": 20, \"junctions\": ["
+                        "{\"id\": 7, \"x\": 0, \"y\": 0, \"signals\": [{\"dir\": 1, \"time\": 5}]}, "
+                        "{\"id\": 3, \"x\": 1, \"y\": 0, \"signals\": [{\"dir\": 3, \"time\": 6}, {\"dir\": 0, "
+                        "\"time\": 7}]}, {\"id\": 9, \"x\": 1, \"y\": 1, \"signals\": [{\"dir\": 2, \"time\": 8}]}], "
+                        "\"roads\": [{\"junction1\": 7, \"junction2\": 3, \"lanes\": 2, \"limit\": 50}, "
+                        "{\"junction1\": 3, \"junction2\": 9, \"lanes\": 1, \"limit\": 30}], \"cars\": ["
+                        "{\"id\": 4, \"target_velocity\": 40, \"max_acceleration\": 2, \"target_deceleration\": 3, "
+                        "\"min_distance\": 3, \"target_headway\": 2, \"politeness\": 0.25, \"start\": {\"from\": 7, "
+                        "\"to\": 3, \"lane\": 1, \"distance\": 12.5}, \"route\": [2, 0, 3]}, "
+                        "{\"id\": 1, \"target_velocity\": 20, \"max_acceleration\": 1.5, \"target_deceleration\": 2, "
+                        "\"min_distance\": 4, \"target_headway\": 1.5, \"politeness\": 0.75, \"start\": {\"from\": 9, "
+                        "\"to\": 3, \"lane\": 0, \"distance\": 40}, \"route\": [1]}]}");
+  JSONReader reader(in);
+  reader.readInto(model);
+
+  std::ostringstream out;
+  BinaryScenarioWriter(out).writeScenario(model, reader.getMode(), reader.getTimeSteps(), 0);
+  return out.str();
+}
+
+/** Returns whether the BinaryScenarioReader rejects the given binary scenario. */
+bool isRejectedBinaryScenario(const std::string &scenario) {
+  std::istringstream in(scenario);
+  DomainModel model;
+  BinaryScenarioReader reader(in);
+  try {
+    reader.readInto(model);
+  } catch (const BinaryScenarioReader::Exception &) { return true; }
+  return false;
+}
+
+/** Overwrites the record at the given offset of the binary scenario. */
+template <typename Record>
+void setRecord(std::string &scenario, const std::size_t offset, const Record &record) {
+  std::memcpy(&scenario[offset], &record, sizeof(Record));
+}
+
+template <typename Record>
+Record getRecord(const std::string &scenario, const std::size_t offset) {
+  Record record;
+  std::memcpy(&record, &scenario[offset], sizeof(Record));
+  return record;
+}
+
+/*
+ * Test if a scenario read from JSON, written by the BinaryScenarioWriter and read by the BinaryScenarioReader results
+ * in the same domain model.
+ */
+void binaryScenarioRoundTripTest() {
+  DomainModel expected;
+  const std::string scenario = writeBinaryTestScenario(expected);
+
+  std::istringstream in(scenario);
+  AssertThat(BinaryScenarioReader::isBinaryScenario(in), Is().True());
+  DomainModel actual;
+  BinaryScenarioReader reader(in);
+  reader.readInto(actual);
+  AssertThat(reader.getTimeSteps(), Is().EqualTo(20u));
+  AssertThat(reader.getMode(), Is().EqualTo(JSONReader::SIMULATE));
+
+  AssertThat(actual.getJunctions().size(), Is().EqualTo(expected.getJunctions().size()));
+  for (std::size_t i = 0; i < expected.getJunctions().size(); ++i) {
+    const Junction &expectedJunction = expected.getJunctions()[i];
+    const Junction &actualJunction   = actual.getJunctions()[i];
+    AssertThat(actualJunction.getExternalId(), Is().EqualTo(expectedJunction.getExternalId()));
+    AssertThat(actualJunction.getX(), Is().EqualTo(expectedJunction.getX()));
+    AssertThat(actualJunction.getY(), Is().EqualTo(expectedJunction.getY()));
+    AssertThat(actualJunction.getSignals().size(), Is().EqualTo(expectedJunction.getSignals().size()));
+    for (std::size_t s = 0; s < expectedJunction.getSignals().size(); ++s) {
+      AssertThat(actualJunction.getSignals()[s].getDirection(),
+          Is().EqualTo(expectedJunction.getSignals()[s].getDirection()));
+      AssertThat(
+          actualJunction.getSignals()[s].getDuration(), Is().EqualTo(expectedJunction.getSignals()[s].getDuration()));
+    }
+    for (unsigned direction = NORTH; direction <= WEST; ++direction) {
+      const auto &expectedIncoming = expectedJunction.getIncomingStreets()[direction];
+      const auto &actualIncoming   = actualJunction.getIncomingStreets()[direction];
+      AssertThat(actualIncoming.isConnected(), Is().EqualTo(expectedIncoming.isConnected()));
+      if (expectedIncoming.isConnected()) {
+        AssertThat(actualIncoming.getStreet()->getId(), Is().EqualTo(expectedIncoming.getStreet()->getId()));
+      }
+      const auto &expectedOutgoing = expectedJunction.getOutgoingStreets()[direction];
+      const auto &actualOutgoing   = actualJunction.getOutgoingStreets()[direction];
+      AssertThat(actualOutgoing.isConnected(), Is().EqualTo(expectedOutgoing.isConnected()));
+      if (expectedOutgoing.isConnected()) {
+        AssertThat(actualOutgoing.getStreet()->getId(), Is().EqualTo(expectedOutgoing.getStreet()->getId()));
+      }
+    }
+  }
+
+  AssertThat(actual.getStreets().size(), Is().EqualTo(expected.getStreets().size()));
+  for (std::size_t i = 0; i < expected.getStreets().size(); ++i) {
+    const Street &expectedStreet = expected.getStreets()[i];
+    const Street &actualStreet   = actual.getStreets()[i];
+    AssertThat(actualStreet.getLanes(), Is().EqualTo(expectedStreet.getLanes()));
+    AssertThat(actualStreet.getSpeedLimit(), Is().EqualTo(expectedStreet.getSpeedLimit()));
+    AssertThat(actualStreet.getLength(), Is().EqualTo(expectedStreet.getLength()));
+    AssertThat(actualStreet.getSourceJunction().getId(), Is().EqualTo(expectedStreet.getSourceJunction().getId()));
+    AssertThat(actualStreet.getTargetJunction().getId(), Is().EqualTo(expectedStreet.getTargetJunction().getId()));
+  }
+
+  AssertThat(actual.getVehicles().size(), Is().EqualTo(expected.getVehicles().size()));
+  for (std::size_t i = 0; i < expected.getVehicles().size(); ++i) {
+    const Vehicle &expectedVehicle = expected.getVehicles()[i];
+    const Vehicle &actualVehicle   = actual.getVehicles()[i];
+    AssertThat(actualVehicle.getExternalId(), Is().EqualTo(expectedVehicle.getExternalId()));
+    AssertThat(actualVehicle.getTargetVelocity(), Is().EqualTo(expectedVehicle.getTargetVelocity()));
+    AssertThat(actualVehicle.getMaxAcceleration(), Is().EqualTo(expectedVehicle.getMaxAcceleration()));
+    AssertThat(actualVehicle.getTargetDeceleration(), Is().EqualTo(expectedVehicle.getTargetDeceleration()));
+    AssertThat(actualVehicle.getMinDistance(), Is().EqualTo(expectedVehicle.getMinDistance()));
+    AssertThat(actualVehicle.getTargetHeadway(), Is().EqualTo(expectedVehicle.getTargetHeadway()));
+    AssertThat(actualVehicle.getPoliteness(), Is().EqualTo(expectedVehicle.getPoliteness()));
+    AssertThat(actualVehicle.getRoute() == expectedVehicle.getRoute(), Is().True());
+    AssertThat(actualVehicle.getPosition().getStreet()->getId(),
+        Is().EqualTo(expectedVehicle.getPosition().getStreet()->getId()));
+    AssertThat(actualVehicle.getPosition().getLane(), Is().EqualTo(expectedVehicle.getPosition().getLane()));
+    AssertThat(actualVehicle.getPosition().getDistance(), Is().EqualTo(expectedVehicle.getPosition().getDistance()));
+  }
+}
+
+/*
+ * Test if truncated scenarios, indices out of range, duplicate ids and invalid politeness values are rejected.
+ */
+void binaryScenarioInvalidInputTest() {
+  using Format = BinaryScenarioFormat;
+  DomainModel model;
+  const std::string scenario = writeBinaryTestScenario(model);
+  AssertThat(isRejectedBinaryScenario(scenario), Is().EqualTo(false));
+
+  // truncated within the header and within the records
+  AssertThat(isRejectedBinaryScenario(scenario.substr(0, sizeof(Format::Header) - 1)), Is().True());
+  AssertThat(isRejectedBinaryScenario(scenario.substr(0, scenario.size() - 8)), Is().True());
+
+  const auto header                 = getRecord<Format::Header>(scenario, 0);
+  const std::size_t junctionsOffset = sizeof(Format::Header);
+  const std::size_t signalsOffset   = junctionsOffset + header.junctionCount * sizeof(Format::JunctionRecord);
+  const std::size_t streetsOffset   = signalsOffset + header.signalCount * sizeof(Format::SignalRecord);
+  const std::size_t vehiclesOffset  = streetsOffset + header.streetCount * sizeof(Format::StreetRecord);
+
+  std::string invalid   = scenario; // street from a junction out of range
+  auto street           = getRecord<Format::StreetRecord>(scenario, streetsOffset);
+  street.sourceJunction = header.junctionCount;
+  setRecord(invalid, streetsOffset, street);
+  AssertThat(isRejectedBinaryScenario(invalid), Is().True());
+
+  invalid                        = scenario; // junction connected to a street out of range
+  auto junction                  = getRecord<Format::JunctionRecord>(scenario, junctionsOffset);
+  junction.outgoingStreets[EAST] = header.streetCount;
+  setRecord(invalid, junctionsOffset, junction);
+  AssertThat(isRejectedBinaryScenario(invalid), Is().True());
+
+  invalid        = scenario; // vehicle on a street out of range
+  auto vehicle   = getRecord<Format::VehicleRecord>(scenario, vehiclesOffset);
+  vehicle.street = header.streetCount;
+  setRecord(invalid, vehiclesOffset, vehicle);
+  AssertThat(isRejectedBinaryScenario(invalid), Is().True());
+
+  invalid             = scenario; // the second junction has the id of the first one
+  junction            = getRecord<Format::JunctionRecord>(scenario, junctionsOffset + sizeof(Format::JunctionRecord));
+  junction.externalId = getRecord<Format::JunctionRecord>(scenario, junctionsOffset).externalId;
+  setRecord(invalid, junctionsOffset + sizeof(Format::JunctionRecord), junction);
+  AssertThat(isRejectedBinaryScenario(invalid), Is().True());
+
+  invalid            = scenario; // the second vehicle has the id of the first one
+  vehicle            = getRecord<Format::VehicleRecord>(scenario, vehiclesOffset + sizeof(Format::VehicleRecord));
+  vehicle.externalId = getRecord<Format::VehicleRecord>(scenario, vehiclesOffset).externalId;
+  setRecord(invalid, vehiclesOffset + sizeof(Format::VehicleRecord), vehicle);
+  AssertThat(isRejectedBinaryScenario(invalid), Is().True());
+
+  for (const double politeness : {-0.5, 1.5}) {
+    invalid            = scenario;
+    vehicle            = getRecord<Format::VehicleRecord>(scenario, vehiclesOffset);
+    vehicle.politeness = politeness;
+    setRecord(invalid, vehiclesOffset, vehicle);
+    AssertThat(isRejectedBinaryScenario(invalid), Is().True());
+  }
+}
+
+#endif
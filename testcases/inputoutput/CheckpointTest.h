@@ -0,0 +1,125 @@
+#ifndef CHECKPOINT_TEST_H
+#define CHECKPOINT_TEST_H
+
+#include "../optimization/OptimizationTestFactory.h"
+#include "BinaryScenarioFormat.h"
+#include "CheckpointFile.h"
+#include "ConsistencyRoutine.h"
+#include "IDMRoutine.h"
+#include "InitialTrafficLightStrategies.h"
+#include "ModelSyncer.h"
+#include "NaiveStreetDataStructure.h"
+#include "NullRoutine.h"
+#include "Simulator.h"
+#include "TrafficLightRoutine.h"
+#include <../../snowhouse/snowhouse.h>
+
+#include <cstring>
+#include <sstream>
+#include <string>
+#include <tuple>
+#include <vector>
+
+using namespace snowhouse;
+
+template <template <typename Vehicle> typename RfbStructure>
+using CheckpointTestSimulator =
+    Simulator<RfbStructure, TrafficLightRoutine, IDMRoutine, NullRoutine, ConsistencyRoutine>;
+
+/** Returns the signal of each low level street and the id, lane, distance, velocity and travel distance of its cars. */
+template <template <typename Vehicle> typename RfbStructure>
+std::vector<std::tuple<unsigned, unsigned, unsigned, double, double, double>> getSimulationState(
+    const CheckpointTestSimulator<RfbStructure> &simulator) {
+  std::vector<std::tuple<unsigned, unsigned, unsigned, double, double, double>> state;
+  for (const auto &street : simulator.getData().getStreets()) {
+    state.emplace_back(street.getId(), street.getSignal(), 0, 0.0, 0.0, 0.0);
+    for (const auto &car : street.allIterable()) {
+      state.emplace_back(street.getId(), car.getId(), car.getLane(), car.getDistance(), car.getVelocity(),
+          car.getTravelDistance());
+    }
+  }
+  return state;
+}
+
+/** Builds the test model with simple signals, all simulations of this test start from it. */
+void createCheckpointTestModel(DomainModel &model) {
+  createOptimizationTestModel(model);
+  InitialTrafficLightsAllFive()(model);
+  model.resetModel();
+}
+
+/*
+ * Test if a simulation resumed from a checkpoint ends in the same state as an uninterrupted simulation.
+ */
+template <template <typename Vehicle> typename RfbStructure>
+void checkpointResumeTest() {
+  const unsigned checkpointStep = 37, stepCount = 100;
+  DomainModel model;
+  createCheckpointTestModel(model);
+  CheckpointTestSimulator<RfbStructure> simulator(model);
+  simulator.performSteps(checkpointStep);
+  std::stringstream checkpoint;
+  ModelSyncer<RfbStructure>(simulator.getData()).writeCheckpoint(checkpoint, checkpointStep);
+  simulator.performSteps(stepCount - checkpointStep);
+
+  DomainModel resumedModel;
+  createCheckpointTestModel(resumedModel);
+  CheckpointTestSimulator<RfbStructure> resumedSimulator(resumedModel);
+  AssertThat(resumedSimulator.restoreCheckpoint(checkpoint), Is().EqualTo(checkpointStep));
+  resumedSimulator.performSteps(stepCount - checkpointStep);
+
+  AssertThat(getSimulationState<RfbStructure>(resumedSimulator) == getSimulationState<RfbStructure>(simulator),
+      Is().True());
+  for (std::size_t i = 0; i < model.getVehicles().size(); ++i) {
+    AssertThat(resumedModel.getVehicle(i).getPosition().getDistance(),
+        Is().EqualTo(model.getVehicle(i).getPosition().getDistance()));
+  }
+}
+
+/** Returns whether restoring the given checkpoint into a new simulation of the test model fails. */
+bool isRejectedCheckpoint(const std::string &checkpoint) {
+  DomainModel model;
+  createCheckpointTestModel(model);
+  CheckpointTestSimulator<NaiveStreetDataStructure> simulator(model);
+  std::istringstream in(checkpoint);
+  try {
+    simulator.restoreCheckpoint(in);
+  } catch (const CheckpointFile::Exception &) { return true; }
+  return false;
+}
+
+/*
+ * Test if checkpoints with a vehicle listed twice or a car beyond the end of its street are rejected.
+ */
+void checkpointInvalidCarTest() {
+  using Format = BinaryScenarioFormat;
+  DomainModel model;
+  createCheckpointTestModel(model);
+  CheckpointTestSimulator<NaiveStreetDataStructure> simulator(model);
+  simulator.performSteps(10);
+  std::ostringstream out;
+  ModelSyncer<NaiveStreetDataStructure>(simulator.getData()).writeCheckpoint(out, 10);
+  const std::string checkpoint = out.str();
+  AssertThat(isRejectedCheckpoint(checkpoint), Is().EqualTo(false));
+
+  Format::CheckpointHeader header;
+  std::memcpy(&header, checkpoint.data(), sizeof(header));
+  const std::size_t carsOffset = sizeof(Format::CheckpointHeader) +
+                                 header.junctionCount * sizeof(Format::JunctionStateRecord) +
+                                 header.streetCount * sizeof(Format::StreetStateRecord);
+  Format::CarStateRecord first, second;
+  std::memcpy(&first, checkpoint.data() + carsOffset, sizeof(first));
+  std::memcpy(&second, checkpoint.data() + carsOffset + sizeof(first), sizeof(second));
+
+  std::string invalid = checkpoint; // the first vehicle is listed twice, the second one is missing
+  second.vehicle      = first.vehicle;
+  std::memcpy(&invalid[carsOffset + sizeof(first)], &second, sizeof(second));
+  AssertThat(isRejectedCheckpoint(invalid), Is().True());
+
+  invalid        = checkpoint; // the first car is beyond the end of its street
+  first.distance = 1e6;
+  std::memcpy(&invalid[carsOffset], &first, sizeof(first));
+  AssertThat(isRejectedCheckpoint(invalid), Is().True());
+}
+
+#endif
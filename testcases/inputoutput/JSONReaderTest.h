@@ -0,0 +1,60 @@
+#ifndef JSON_READER_TEST_H
+#define JSON_READER_TEST_H
+
+#include "DomainModel.h"
+#include "JSONReader.h"
+#include <../../snowhouse/snowhouse.h>
+
+#include <sstream>
+#include <string>
+
+using namespace snowhouse;
+
+/** Returns whether the given input is rejected by the JSONReader. */
+bool isRejectedInput(const std::string &header, const std::string &signals, const std::string &limit = "50") {
+  std::istringstream in("{" + header + ", \"junctions\": [{\"id\": 0, \"x\": 0, \"y\": 0, \"signals\": " + signals +
+                        "}, {\"id\": 1, \"x\": 1, \"y\": 0, \"signals\": []}], \"roads\": [{\"junction1\": 0, "
+                        "\"junction2\": 1, \"lanes\": 1, \"limit\": " +
+                        limit + "}], \"cars\": []}");
+  DomainModel model;
+  JSONReader reader(in);
+  try {
+    reader.readInto(model);
+  } catch (const std::exception &) { return true; }
+  return false;
+}
+
+/*
+ * Test if signals are only required in SIMULATE mode, also if the mode is given after the junctions.
+ */
+void jsonReaderSignalsTest() {
+  const std::string simulate = "\"time_steps\": 10";
+  const std::string optimize = "\"time_steps\": 10, \"optimize_signals\": true, \"min_travel_distance\": 100";
+  AssertThat(isRejectedInput(simulate, "[{\"dir\": 1, \"time\": 5}]"), Is().EqualTo(false));
+  AssertThat(isRejectedInput(simulate, "[{\"time\": 5}]"), Is().True());
+  AssertThat(isRejectedInput(simulate, "[{\"dir\": 4, \"time\": 5}]"), Is().True());
+  AssertThat(isRejectedInput(optimize, "[{\"time\": 5}]"), Is().EqualTo(false));
+  AssertThat(isRejectedInput(optimize, "[{\"dir\": 4}]"), Is().EqualTo(false));
+
+  std::istringstream in("{\"time_steps\": 10, \"junctions\": [{\"id\": 0, \"x\": 0, \"y\": 0, \"signals\": "
+                        "[{\"time\": 5}]}], \"optimize_signals\": true, \"min_travel_distance\": 100}");
+  DomainModel model;
+  JSONReader reader(in);
+  reader.readInto(model);
+  AssertThat(reader.getMode(), Is().EqualTo(JSONReader::OPTIMIZE));
+  AssertThat(model.getJunction(0).getSignals().size(), Is().EqualTo(0u));
+}
+
+/*
+ * Test if booleans are rejected for numeric values and numbers for optimize_signals.
+ */
+void jsonReaderTypesTest() {
+  const std::string header = "\"time_steps\": 10";
+  AssertThat(isRejectedInput(header, "[]", "true"), Is().True());
+  AssertThat(isRejectedInput(header, "[{\"dir\": true, \"time\": 5}]"), Is().True());
+  AssertThat(isRejectedInput("\"time_steps\": false", "[]"), Is().True());
+  AssertThat(isRejectedInput(header + ", \"optimize_signals\": 1, \"min_travel_distance\": 100", "[]"), Is().True());
+  AssertThat(isRejectedInput(header + ", \"optimize_signals\": false", "[]"), Is().EqualTo(false));
+}
+
+#endif
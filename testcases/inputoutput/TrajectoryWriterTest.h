@@ -0,0 +1,43 @@
+#ifndef TRAJECTORY_WRITER_TEST_H
+#define TRAJECTORY_WRITER_TEST_H
+
+#include "BinaryScenarioFormat.h"
+#include "TrajectoryWriter.h"
+#include <../../snowhouse/snowhouse.h>
+
+#include <cstring>
+#include <sstream>
+#include <string>
+
+using namespace snowhouse;
+
+/*
+ * Test if all frames are written, also if the last one is submitted right before finish(). The race between the
+ * writer thread going to sleep and the final frame is repeated a number of times.
+ */
+void trajectoryWriterLastFrameTest() {
+  using Format                 = BinaryScenarioFormat;
+  const unsigned frameCount    = 3;
+  const std::size_t recordSize = sizeof(Format::FrameHeader) + sizeof(Format::VehiclePositionRecord);
+  for (unsigned run = 0; run < 1000; ++run) {
+    std::ostringstream out;
+    TrajectoryWriter writer(out, 1, 1);
+    for (unsigned step = 0; step < frameCount; ++step) {
+      TrajectoryWriter::Frame &frame = writer.beginFrame(step);
+      frame.positions.push_back(Format::VehiclePositionRecord{0, 0, 1, 0, 1.0 * step});
+      writer.submitFrame();
+    }
+    writer.finish();
+
+    const std::string output = out.str();
+    AssertThat(output.size(), Is().EqualTo(sizeof(Format::TrajectoryHeader) + frameCount * recordSize));
+    for (unsigned step = 0; step < frameCount; ++step) {
+      Format::FrameHeader header;
+      std::memcpy(&header, output.data() + sizeof(Format::TrajectoryHeader) + step * recordSize, sizeof(header));
+      AssertThat(header.step, Is().EqualTo(step));
+      AssertThat(header.vehicleCount, Is().EqualTo(1u));
+    }
+  }
+}
+
+#endif
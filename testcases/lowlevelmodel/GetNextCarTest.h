@@ -124,4 +124,29 @@ void getNextCarTest5() {
   checkNeighbors(street, neighbors);
 }
 
+// Case 6: 2 lane street longer than a MergeNSkip checkpoint interval, the last car's neighbor behind on the other lane
+// is in an earlier section and not directly behind it
+template <template <typename Car> typename Street>
+void getNextCarTest6() {
+  //   0     50    100   150   200
+  // 0:                    3 0
+  // 1:       2          1
+  Street<LowLevelCar> street(2, 200);
+  street.insertCar(createCar(0, 0, 150.7));
+  street.insertCar(createCar(1, 1, 143.6));
+  street.insertCar(createCar(2, 1, 60));
+  street.insertCar(createCar(3, 0, 145));
+  street.incorporateInsertedCars();
+
+  std::vector<NeighborDef> neighbors;
+  neighbors.push_back(NeighborDef(0, 1, 1, behind));
+  neighbors.push_back(NeighborDef(0, -1, 1, inFront));
+  neighbors.push_back(NeighborDef(0, 3, 0, behind));
+  neighbors.push_back(NeighborDef(1, 3, -1, inFront));
+  neighbors.push_back(NeighborDef(1, -1, -1, behind));
+  neighbors.push_back(NeighborDef(1, 2, 0, behind));
+  neighbors.push_back(NeighborDef(2, 1, 0, inFront));
+  checkNeighbors(street, neighbors);
+}
+
 #endif
\ No newline at end of file
@@ -0,0 +1,62 @@
+#ifndef HEURISTIC_SIMULATOR_TEST_H
+#define HEURISTIC_SIMULATOR_TEST_H
+
+#include "DomainModel.h"
+#include "HeuristicSimulator.h"
+#include <../../snowhouse/snowhouse.h>
+
+using namespace snowhouse;
+
+/*
+ * Test if a car stops at the end of a one way street whose target junction has no outgoing street:
+ *  x-->x
+ */
+void heuristicSimulatorDeadEndTest() {
+  DomainModel model;
+  const std::vector<Junction::Signal> signals;
+  Junction &from = model.addJunction(Junction(0, 0, 0, 0, signals));
+  Junction &to   = model.addJunction(Junction(1, 1, 1, 0, signals));
+  Street &street = model.addStreet(Street(0, 1, 10.0, 100.0, from, to));
+  from.addOutgoingStreet(street, CardinalDirection::EAST);
+  to.addIncomingStreet(street, CardinalDirection::WEST);
+  const std::vector<TurnDirection> route{TurnDirection::STRAIGHT};
+  model.addVehicle(Vehicle(0, 0, 20.0, 1.0, 1.0, 2.0, 1.0, 0.5, route, Vehicle::Position(street, 0, 5.0)));
+
+  HeuristicSimulator heuristicSimulator(model);
+  heuristicSimulator.performSteps(50);
+  AssertThat(heuristicSimulator.getTravelDistance(0), Is().EqualTo(95.0));
+}
+
+/*
+ * Test if only the speed limits of streets on the route of a car are considered. The car starts on the left street,
+ * it only reaches the faster right street if it drives straight at the middle junction:
+ *  x<=>x<=>x
+ */
+void heuristicSimulatorRouteSpeedLimitTest() {
+  for (const TurnDirection turn : {TurnDirection::UTURN, TurnDirection::STRAIGHT}) {
+    DomainModel model;
+    const std::vector<Junction::Signal> signals;
+    Junction &left   = model.addJunction(Junction(0, 0, 0, 0, signals));
+    Junction &middle = model.addJunction(Junction(1, 1, 1, 0, signals));
+    Junction &right  = model.addJunction(Junction(2, 2, 2, 0, signals));
+    Street &toMiddle = model.addStreet(Street(0, 1, 10.0, 100.0, left, middle));
+    Street &toLeft   = model.addStreet(Street(1, 1, 10.0, 100.0, middle, left));
+    Street &toRight  = model.addStreet(Street(2, 1, 30.0, 100.0, middle, right));
+    Street &back     = model.addStreet(Street(3, 1, 30.0, 100.0, right, middle));
+    left.addOutgoingStreet(toMiddle, CardinalDirection::EAST);
+    left.addIncomingStreet(toLeft, CardinalDirection::EAST);
+    middle.addIncomingStreet(toMiddle, CardinalDirection::WEST);
+    middle.addOutgoingStreet(toLeft, CardinalDirection::WEST);
+    middle.addOutgoingStreet(toRight, CardinalDirection::EAST);
+    middle.addIncomingStreet(back, CardinalDirection::EAST);
+    right.addIncomingStreet(toRight, CardinalDirection::WEST);
+    right.addOutgoingStreet(back, CardinalDirection::WEST);
+    const std::vector<TurnDirection> route{turn};
+    model.addVehicle(Vehicle(0, 0, 50.0, 1.0, 1.0, 2.0, 1.0, 0.5, route, Vehicle::Position(toMiddle, 0, 5.0)));
+
+    HeuristicSimulator heuristicSimulator(model);
+    AssertThat(heuristicSimulator.getMaxSpeedLimitOnRoute(0), Is().EqualTo(turn == TurnDirection::UTURN ? 10.0 : 30.0));
+  }
+}
+
+#endif
@@ -0,0 +1,110 @@
+#ifndef INITIAL_TRAFFIC_LIGHT_STRATEGIES_TEST_H
+#define INITIAL_TRAFFIC_LIGHT_STRATEGIES_TEST_H
+
+#include "InitialTrafficLightStrategies.h"
+#include "TrafficLightCrossingUtils.h"
+#include <../../snowhouse/snowhouse.h>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+using namespace snowhouse;
+
+/**
+ * Determines the traffic light order with minimal total wait time by trying all permutations, the first one in
+ * lexicographic order wins ties. Returns the wait time and the order.
+ */
+template <typename Strategy>
+std::pair<double, std::vector<unsigned>> determineBestOrderExhaustively(
+    const Strategy &strategy, const CycleTrafficLightRating &rating, const std::vector<unsigned> &duration) {
+  std::vector<unsigned> order(duration.size());
+  for (unsigned i = 0; i < order.size(); ++i) { order[i] = i; }
+  std::pair<double, std::vector<unsigned>> best(-1, order);
+  do {
+    double waitTime = 0;
+    for (unsigned position = 0, offset = 0; position < order.size(); offset += duration[order[position++]]) {
+      waitTime += strategy.getWaitTime(rating, order[position], offset, duration[order[position]]);
+    }
+    if (best.first < 0 || waitTime < best.first) { best = std::make_pair(waitTime, order); }
+  } while (std::next_permutation(order.begin(), order.end()));
+  return best;
+}
+
+/** Rates the given crossings per street with the total duration as cycle length. */
+CycleTrafficLightRating rateCrossings(const std::vector<std::vector<TrafficLightCrossing>> &crossings,
+    const std::vector<unsigned> &duration, const std::vector<double> *carPriorities) {
+  std::vector<TrafficLightCrossingRange> crossingsPerStreet;
+  for (const auto &streetCrossings : crossings) {
+    crossingsPerStreet.push_back(
+        TrafficLightCrossingRange(streetCrossings.data(), streetCrossings.data() + streetCrossings.size()));
+  }
+  unsigned cycleLength = 0;
+  for (const unsigned streetDuration : duration) { cycleLength += streetDuration; }
+  return CycleTrafficLightRating(crossingsPerStreet, cycleLength, carPriorities);
+}
+
+/*
+ * Test if the branch-and-bound order search finds the same best order as trying all permutations for random junctions
+ * with and without car priorities.
+ */
+void orderSearchTest() {
+  const InitialTrafficLightsWithHeuristicSimulatorAndIteration<false> strategy;
+  const InitialTrafficLightsWithHeuristicSimulatorAndIteration<true> strategyWithPriority;
+
+  std::default_random_engine randomEngine(7);
+  std::uniform_int_distribution<unsigned> streetCountDist(1, 5), durationDist(5, 15), crossingCountDist(0, 10),
+      timeStepDist(0, 100);
+  std::uniform_real_distribution<double> priorityDist(0, 100);
+  const unsigned carCount = 20;
+  std::uniform_int_distribution<unsigned> carDist(0, carCount - 1);
+
+  for (unsigned run = 0; run < 100; ++run) {
+    const unsigned streetCount = streetCountDist(randomEngine);
+    std::vector<double> carPriorities(carCount);
+    for (auto &priority : carPriorities) { priority = priorityDist(randomEngine); }
+    std::vector<std::vector<TrafficLightCrossing>> crossings(streetCount);
+    std::vector<unsigned> duration(streetCount);
+    for (unsigned streetIndex = 0; streetIndex < streetCount; ++streetIndex) {
+      for (unsigned i = crossingCountDist(randomEngine); i > 0; --i) {
+        crossings[streetIndex].push_back(
+            TrafficLightCrossing(carDist(randomEngine), streetIndex, timeStepDist(randomEngine)));
+      }
+      duration[streetIndex] = durationDist(randomEngine);
+    }
+
+    const CycleTrafficLightRating rating = rateCrossings(crossings, duration, &carPriorities);
+    const bool isExhaustiveOrder =
+        strategy.determineBestOrder(rating, duration) == determineBestOrderExhaustively(strategy, rating, duration);
+    AssertThat(isExhaustiveOrder, Is().True());
+    const bool isExhaustiveOrderWithPriority = strategyWithPriority.determineBestOrder(rating, duration) ==
+                                               determineBestOrderExhaustively(strategyWithPriority, rating, duration);
+    AssertThat(isExhaustiveOrderWithPriority, Is().True());
+  }
+}
+
+/*
+ * Test if the order search prunes partial orders reaching the best known wait time without losing the first optimal
+ * order: Only cars at the beginning of the cycle on the third street wait, unless its light is green first. All orders
+ * starting with the third street are optimal. Once the first of them is found, all later orders are pruned after their
+ * first signal.
+ */
+void orderSearchPruningTest() {
+  const InitialTrafficLightsWithHeuristicSimulatorAndIteration<false> strategy;
+  const std::vector<unsigned> duration{5, 5, 5, 5};
+  std::vector<std::vector<TrafficLightCrossing>> crossings(4);
+  crossings[2] = {TrafficLightCrossing(0, 2, 0), TrafficLightCrossing(1, 2, 1), TrafficLightCrossing(2, 2, 22)};
+
+  const CycleTrafficLightRating rating = rateCrossings(crossings, duration, 0);
+  const auto best                      = strategy.determineBestOrder(rating, duration);
+  AssertThat(best.first, Is().EqualTo(0.0));
+  AssertThat(best.second == std::vector<unsigned>({2, 0, 1, 3}), Is().True());
+  AssertThat(best == determineBestOrderExhaustively(strategy, rating, duration), Is().True());
+
+  crossings[2].clear(); // no car waits for any order, i.e. the first order is kept
+  const CycleTrafficLightRating emptyRating = rateCrossings(crossings, duration, 0);
+  const auto firstOrder                     = strategy.determineBestOrder(emptyRating, duration).second;
+  AssertThat(firstOrder == std::vector<unsigned>({0, 1, 2, 3}), Is().True());
+}
+
+#endif
@@ -0,0 +1,63 @@
+#ifndef OPTIMIZATIONTESTFACTORY_H
+
+#define OPTIMIZATIONTESTFACTORY_H
+
+#include "DomainModel.h"
+#include "JSONReader.h"
+
+#include <sstream>
+#include <string>
+
+/*
+ * Reads a small optimization scenario into the given model: a grid of 3x3 junctions 200 m apart, which are connected
+ * by two lane roads, and cars spread over all streets, which drive along different routes. The signals of all junctions
+ * are left empty, they are set by the initial traffic light strategy of the Optimizer.
+ */
+void createOptimizationTestModel(DomainModel &model, const unsigned carCount = 60) {
+  const int gridSize = 3;
+  std::ostringstream json;
+  json << "{\"optimize_signals\": true, \"time_steps\": 100, \"min_travel_distance\": 1000000, \"junctions\": [";
+  for (int id = 0; id < gridSize * gridSize; ++id) {
+    json << (id > 0 ? ", " : "") << "{\"id\": " << id << ", \"x\": " << 2 * (id % gridSize)
+         << ", \"y\": " << 2 * (id / gridSize) << ", \"signals\": []}";
+  }
+  json << "], \"roads\": [";
+  unsigned roadCount = 0;
+  std::ostringstream roads;
+  for (int id = 0; id < gridSize * gridSize; ++id) {
+    if (id % gridSize + 1 < gridSize) {
+      json << (roadCount++ > 0 ? ", " : "") << "{\"junction1\": " << id << ", \"junction2\": " << id + 1
+           << ", \"lanes\": 2, \"limit\": 50}";
+      roads << id << " " << id + 1 << " ";
+    }
+    if (id / gridSize + 1 < gridSize) {
+      json << (roadCount++ > 0 ? ", " : "") << "{\"junction1\": " << id << ", \"junction2\": " << id + gridSize
+           << ", \"lanes\": 2, \"limit\": 50}";
+      roads << id << " " << id + gridSize << " ";
+    }
+  }
+  json << "], \"cars\": [";
+  const std::string routes[] = {"[0]", "[1, 2]", "[3, 0, 1]", "[2, 2, 3]"};
+  std::istringstream roadList(roads.str());
+  for (unsigned id = 0; id < carCount; ++id) {
+    int from = 0, to = 0;
+    if (!(roadList >> from >> to)) {
+      roadList.clear();
+      roadList.str(roads.str());
+      roadList >> from >> to;
+    }
+    if (id % 2 == 1) { std::swap(from, to); }
+    json << (id > 0 ? ", " : "") << "{\"id\": " << id << ", \"target_velocity\": " << 30 + id % 4 * 10
+         << ", \"max_acceleration\": 2, \"target_deceleration\": 3, \"min_distance\": 3, \"target_headway\": 2"
+         << ", \"politeness\": 0.3, \"start\": {\"from\": " << from << ", \"to\": " << to
+         << ", \"lane\": " << id / 2 % 2 << ", \"distance\": " << 10 + id * 37 % 180
+         << "}, \"route\": " << routes[id % 4] << "}";
+  }
+  json << "]}";
+
+  std::istringstream in(json.str());
+  JSONReader reader(in);
+  reader.readInto(model);
+}
+
+#endif
@@ -0,0 +1,106 @@
+#ifndef OPTIMIZER_TEST_H
+#define OPTIMIZER_TEST_H
+
+#include "AccelerationComputer.h"
+#include "AnnealingOptimizationRoutine.h"
+#include "InitialTrafficLightStrategies.h"
+#include "NaiveStreetDataStructure.h"
+#include "OptimizationRoutine.h"
+#include "OptimizationTestFactory.h"
+#include "Optimizer.h"
+#include "ParallelConsistencyRoutine.h"
+#include "ParallelIDMRoutine.h"
+#include "ParallelTrafficLightRoutine.h"
+#include "RandomOptimizationRoutine.h"
+#include "RegionalOptimizationRoutine.h"
+#include <../../snowhouse/snowhouse.h>
+
+using namespace snowhouse;
+
+template <template <template <typename Vehicle> typename RfbStructure> typename OptimizationRoutine>
+using TestOptimizer = Optimizer<NaiveStreetDataStructure, ParallelTrafficLightRoutine, ParallelIDMRoutine,
+    OptimizationRoutine, ParallelConsistencyRoutine, InitialTrafficLightsWithHeuristicSimulatorAndIteration<false>>;
+
+/*
+ * Asserts that each junction has at most one signal per connected incoming street and none for unconnected directions,
+ * each with a positive duration. Streets no car passes may have no signal, see the initial traffic light strategies.
+ */
+void assertValidSignalPlan(const DomainModel &model) {
+  for (const auto &junction : model.getJunctions()) {
+    std::array<unsigned, 4> signalsPerDirection{};
+    for (const auto &signal : junction.getSignals()) {
+      AssertThat(signal.getDuration(), Is().Not().EqualTo(0u));
+      ++signalsPerDirection[signal.getDirection()];
+    }
+    for (const auto &street : junction.getIncomingStreets()) {
+      if (!street.isConnected()) { AssertThat(signalsPerDirection[street.getDirection()], Is().EqualTo(0u)); }
+      AssertThat(signalsPerDirection[street.getDirection()] <= 1, Is().True());
+    }
+  }
+}
+
+/*
+ * Test if the velocity of a car accelerating on a free street stays below the bound used to stop optimization cycles
+ * early, also if the velocity update overshoots the desired velocity.
+ */
+void maxReachableVelocityTest() {
+  for (const double desiredVelocity : {5.0, 13.9, 50.0}) {
+    for (const double maxAcceleration : {0.5, 2.0, 8.0, 20.0}) {
+      const double bound = getMaxReachableVelocity(desiredVelocity, maxAcceleration);
+      double velocity = 0, maxVelocity = 0;
+      for (int step = 0; step < 1000; ++step) {
+        velocity    = std::max(velocity + maxAcceleration * (1 - std::pow(velocity / desiredVelocity, 4)), 0.0);
+        maxVelocity = std::max(maxVelocity, velocity);
+      }
+      AssertThat(bound >= desiredVelocity, Is().True());
+      AssertThat(maxVelocity <= bound * (1 + 1e-12), Is().True());
+    }
+  }
+  AssertThat(getMaxReachableVelocity(5.0, 2.0) > 5.0, Is().True());
+}
+
+/*
+ * Test if the Optimizer runs with the given optimization routine, sequentially and with concurrent candidates, and
+ * leaves a valid signal plan. The minimum travel distance cannot be reached, i.e. all cycles are run.
+ */
+template <template <template <typename Vehicle> typename RfbStructure> typename OptimizationRoutine>
+void optimizerTest() {
+  for (const unsigned candidateCount : {1u, 2u}) {
+    DomainModel model;
+    createOptimizationTestModel(model);
+    TestOptimizer<OptimizationRoutine> optimizer(model, 100, 1e9, 3, candidateCount);
+    optimizer.optimizeTrafficLights();
+    assertValidSignalPlan(model);
+  }
+}
+
+/*
+ * Test if successive halving promotes the better half of the signal plans on each fidelity level, such that the number
+ * of plans simulated completely equals the number of candidates.
+ */
+void optimizerFidelityLevelsTest() {
+  const unsigned candidateCount = 2, fidelityLevels = 3, cycles = 2;
+  DomainModel model;
+  createOptimizationTestModel(model);
+  TestOptimizer<AnnealingOptimizationRoutine> optimizer(model, 100, 1e9, cycles, candidateCount, fidelityLevels);
+  optimizer.optimizeTrafficLights();
+  assertValidSignalPlan(model);
+  AssertThat(optimizer.getEvaluatedPlans(0), Is().EqualTo(cycles * 8ull));
+  AssertThat(optimizer.getEvaluatedPlans(1), Is().EqualTo(cycles * 4ull));
+  AssertThat(optimizer.getEvaluatedPlans(2), Is().EqualTo(cycles * 2ull));
+}
+
+/*
+ * Test if fidelity level counts are rejected if the initial population cannot be counted.
+ */
+void fidelityLevelCountTest() {
+  AssertThat(isValidFidelityLevelCount(1, 1), Is().True());
+  AssertThat(isValidFidelityLevelCount(1, 32), Is().True());
+  AssertThat(isValidFidelityLevelCount(1, 33), Is().EqualTo(false));
+  AssertThat(isValidFidelityLevelCount(2, 32), Is().EqualTo(false));
+  AssertThat(isValidFidelityLevelCount(8, 30), Is().EqualTo(false));
+  AssertThat(isValidFidelityLevelCount(8, 29), Is().True());
+  AssertThat(isValidFidelityLevelCount(4, 0), Is().EqualTo(false));
+}
+
+#endif
@@ -0,0 +1,102 @@
+#ifndef REGIONAL_DECOMPOSITION_TEST_H
+#define REGIONAL_DECOMPOSITION_TEST_H
+
+#include "ConsistencyRoutine.h"
+#include "IDMRoutine.h"
+#include "InitialTrafficLightStrategies.h"
+#include "NaiveStreetDataStructure.h"
+#include "NullRoutine.h"
+#include "OptimizationTestFactory.h"
+#include "RegionalDecomposition.h"
+#include "Simulator.h"
+#include "TrafficLightRoutine.h"
+#include <../../snowhouse/snowhouse.h>
+
+#include <algorithm>
+#include <tuple>
+
+using namespace snowhouse;
+
+using RegionTestSimulator = Simulator<NaiveStreetDataStructure, TrafficLightRoutine, IDMRoutine, NullRoutine,
+    ConsistencyRoutine>;
+using RegionTestDecomposition = RegionalDecomposition<NaiveStreetDataStructure, RegionTestSimulator>;
+
+/** Returns the external id, lane, distance and velocity of all cars on the given low level street, ordered. */
+std::vector<std::tuple<unsigned, unsigned, double, double>> getCarStates(
+    const LowLevelStreet<NaiveStreetDataStructure> &street) {
+  std::vector<std::tuple<unsigned, unsigned, double, double>> states;
+  for (const auto &car : street.allIterable()) {
+    states.emplace_back(car.getExternalId(), car.getLane(), car.getDistance(), car.getVelocity());
+  }
+  std::sort(states.begin(), states.end());
+  return states;
+}
+
+/*
+ * Test if the simulation of the neighbourhood of each region reproduces the cars on the streets to and between the
+ * junctions of the region in a simulation of the whole model with the same signal plan.
+ */
+void regionalDecompositionTest() {
+  const unsigned stepCount = 100;
+  DomainModel model;
+  createOptimizationTestModel(model);
+  InitialTrafficLightsAllFive()(model);
+  model.resetModel();
+  const RegionTestSimulator::Snapshot initialLowLevel = RegionTestSimulator(model).takeSnapshot();
+
+  RegionTestDecomposition decomposition(model, 2, stepCount);
+  AssertThat(decomposition.getRegionCount(), Is().EqualTo(4u));
+  RegionTestDecomposition::Inflows inflows;
+  RegionTestSimulator simulator(model, initialLowLevel);
+  decomposition.startRecording(initialLowLevel, inflows);
+  simulator.performStepsUntil(stepCount, [&](const unsigned performedSteps) {
+    decomposition.recordInflows(simulator.getData(), performedSteps, inflows);
+    return false;
+  });
+
+  RegionTestDecomposition::SignalPlan plan;
+  for (const auto &junction : model.getJunctions()) { plan.push_back(junction.getSignals()); }
+  std::size_t comparedStreets = 0, enteringCars = 0;
+  for (std::size_t i = 0; i < decomposition.getRegionCount(); ++i) {
+    RegionTestDecomposition::Region region;
+    decomposition.buildRegion(i, plan, initialLowLevel, inflows[i], region);
+    enteringCars += region.inflows.size();
+
+    RegionTestSimulator regionSimulator(region.model, region.initialLowLevel);
+    RegionTestDecomposition::performSteps(region, regionSimulator, stepCount);
+
+    // the streets leaving the region are extended by at most a queue of all cars, whose minimum distance is 3 m
+    const double maxExtension = TRAFFIC_LIGHT_OFFSET + 2 * region.model.getVehicles().size() * (VEHICLE_LENGTH + 3);
+    for (const auto &regionStreet : region.model.getStreets()) {
+      AssertThat(regionStreet.getLength() - region.streetLengths[regionStreet.getId()] <= maxExtension, Is().True());
+      if (regionStreet.getTargetJunction().getId() >= region.junctionIds.size()) { continue; } // leaves the region
+      for (const auto &street : model.getStreets()) {
+        if (street.getSourceJunction().getExternalId() != regionStreet.getSourceJunction().getExternalId() ||
+            street.getTargetJunction().getExternalId() != regionStreet.getTargetJunction().getExternalId()) {
+          continue;
+        }
+        AssertThat(getCarStates(regionSimulator.getData().getStreet(regionStreet.getId())) ==
+                       getCarStates(simulator.getData().getStreet(street.getId())),
+            Is().True());
+        ++comparedStreets;
+      }
+    }
+  }
+  AssertThat(comparedStreets, Is().EqualTo(model.getStreets().size()));
+  AssertThat(enteringCars > 0, Is().True());
+
+  // the neighbourhood of a single region is the whole model
+  RegionTestDecomposition wholeModel(model, 9, stepCount);
+  AssertThat(wholeModel.getRegionCount(), Is().EqualTo(1u));
+  wholeModel.startRecording(initialLowLevel, inflows);
+  RegionTestDecomposition::Region region;
+  wholeModel.buildRegion(0, plan, initialLowLevel, inflows[0], region);
+  AssertThat(region.model.getStreets().size(), Is().EqualTo(model.getStreets().size()));
+  double travelDistance = 0;
+  for (const auto &street : simulator.getData().getStreets()) {
+    for (const auto &car : street.allIterable()) { travelDistance += car.getTravelDistance(); }
+  }
+  AssertThat(RegionTestDecomposition::simulateRegion(region, stepCount), Is().EqualTo(travelDistance));
+}
+
+#endif
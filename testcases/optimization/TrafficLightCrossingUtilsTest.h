@@ -0,0 +1,83 @@
+#ifndef TRAFFIC_LIGHT_CROSSING_UTILS_TEST_H
+#define TRAFFIC_LIGHT_CROSSING_UTILS_TEST_H
+
+#include "TrafficLightCrossingUtils.h"
+#include <../../snowhouse/snowhouse.h>
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+using namespace snowhouse;
+
+/** Returns whether two sums of priorities are equal up to rounding errors. */
+bool isApproximatelyEqual(const double actual, const double expected) {
+  return std::abs(actual - expected) <= 1e-9 * std::max(1.0, std::abs(expected));
+}
+
+/*
+ * Test if the CycleTrafficLightRating rates random crossings, orders and durations like rating each crossing
+ * separately with getTimeToNextGreen().
+ */
+void cycleTrafficLightRatingTest() {
+  std::default_random_engine randomEngine(42);
+  std::uniform_int_distribution<unsigned> streetCountDist(1, 4), durationDist(1, 20), crossingCountDist(0, 30),
+      timeStepDist(0, 200);
+  std::uniform_real_distribution<double> priorityDist(0, 100);
+  const unsigned carCount = 50;
+  std::uniform_int_distribution<unsigned> carDist(0, carCount - 1);
+
+  for (unsigned run = 0; run < 200; ++run) {
+    const unsigned streetCount = streetCountDist(randomEngine);
+    std::vector<double> carPriorities(carCount);
+    for (auto &priority : carPriorities) { priority = priorityDist(randomEngine); }
+
+    std::vector<std::vector<TrafficLightCrossing>> crossings(streetCount);
+    std::vector<TrafficLightCrossingRange> crossingsPerStreet;
+    std::vector<unsigned> duration(streetCount), order(streetCount);
+    unsigned cycleLength = 0;
+    for (unsigned streetIndex = 0; streetIndex < streetCount; ++streetIndex) {
+      for (unsigned i = crossingCountDist(randomEngine); i > 0; --i) {
+        crossings[streetIndex].push_back(
+            TrafficLightCrossing(carDist(randomEngine), streetIndex, timeStepDist(randomEngine)));
+      }
+      std::sort(crossings[streetIndex].begin(), crossings[streetIndex].end(),
+          [](const TrafficLightCrossing &a, const TrafficLightCrossing &b) { return a.timeStep < b.timeStep; });
+      crossingsPerStreet.push_back(TrafficLightCrossingRange(
+          crossings[streetIndex].data(), crossings[streetIndex].data() + crossings[streetIndex].size()));
+      duration[streetIndex] = durationDist(randomEngine);
+      order[streetIndex]    = streetIndex;
+      cycleLength += duration[streetIndex];
+    }
+    std::shuffle(order.begin(), order.end(), randomEngine);
+
+    CycleTrafficLightRating rating(crossingsPerStreet, cycleLength, &carPriorities);
+    for (unsigned position = 0, offset = 0; position < streetCount; offset += duration[order[position++]]) {
+      const unsigned streetIndex           = order[position];
+      const unsigned green                 = duration[streetIndex];
+      unsigned long long waitTime          = 0;
+      unsigned long long throughputAtGreen = 0;
+      double waitTimeWithPriority          = 0;
+      double throughputAtGreenWithPriority = 0;
+      for (const TrafficLightCrossing &crossing : crossings[streetIndex]) {
+        const unsigned currentWaitTime = getTimeToNextGreen(crossing.timeStep, offset, green, cycleLength);
+        waitTime += currentWaitTime;
+        waitTimeWithPriority += currentWaitTime * carPriorities[crossing.carId];
+        if (currentWaitTime == 0) {
+          throughputAtGreen += 1;
+          throughputAtGreenWithPriority += carPriorities[crossing.carId];
+        }
+      }
+
+      AssertThat(rating.getWaitTime(streetIndex, offset, green), Is().EqualTo(waitTime));
+      AssertThat(rating.getThroughputAtGreen(streetIndex, offset, green), Is().EqualTo(throughputAtGreen));
+      const double priorityWaitTime = rating.getWaitTimeWithPriority(streetIndex, offset, green);
+      AssertThat(isApproximatelyEqual(priorityWaitTime, waitTimeWithPriority), Is().True());
+      const double priorityThroughput = rating.getThroughputAtGreenWithPriority(streetIndex, offset, green);
+      AssertThat(isApproximatelyEqual(priorityThroughput, throughputAtGreenWithPriority), Is().True());
+    }
+  }
+}
+
+#endif
@@ -49,3 +49,31 @@ void calculateOriginDirectionTest() {
     AssertThat(result, Is().EqualTo(direction));
   }
 }
+
+void routingTableTest() {
+  // DOMAIN MODEL SETUP:
+  DomainModel model;
+  Junction other    = createTestJunction();
+  Junction junction = createTestJunction();
+  // clang-format off
+  for (CardinalDirection direction = CardinalDirection::NORTH; direction <= CardinalDirection::WEST;
+       direction = CardinalDirection(direction + 1)) { // clang-format on
+    if (direction == CardinalDirection::WEST) { continue; } // no street to the west, turning there is redirected
+    junction.addIncomingStreet(model.addStreet(Street(0, 2, 50.0, 100.0, other, junction)), direction);
+    junction.addOutgoingStreet(model.addStreet(Street(0, 3, 50.0, 100.0, junction, other)), direction);
+  }
+  Street &north = *junction.getIncomingStreet(CardinalDirection::NORTH).getStreet();
+  const std::vector<TurnDirection> route{TurnDirection::LEFT, TurnDirection::RIGHT};
+  model.addVehicle(Vehicle(0, 0, 45.0, 1.0, 1.0, 10.0, 5.0, 0.5, route, {north, 0, 33.3}));
+  RoutingTable routingTable(model);
+  LowLevelCar car(0, 0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0);
+  // TESTS:
+  const auto &left = routingTable.takeNextTurn(car, north.getId());
+  AssertThat(left.street, Is().EqualTo(junction.getOutgoingStreet(CardinalDirection::EAST).getStreet()->getId()));
+  AssertThat(left.maxLane, Is().EqualTo(2u));
+  AssertThat(car.getRouteIndex(), Is().EqualTo(1u));
+  // turning right from the north leads to the west, the next connected direction clockwise is the north:
+  const auto &right = routingTable.takeNextTurn(car, north.getId());
+  AssertThat(right.street, Is().EqualTo(junction.getOutgoingStreet(CardinalDirection::NORTH).getStreet()->getId()));
+  AssertThat(car.getRouteIndex(), Is().EqualTo(0u));
+}
@@ -0,0 +1,140 @@
+#ifndef OPTIMIZATION_ROUTINE_TEST_H
+#define OPTIMIZATION_ROUTINE_TEST_H
+
+#include "../optimization/OptimizationTestFactory.h"
+#include "BucketList.h"
+#include "ConsistencyRoutine.h"
+#include "IDMRoutine.h"
+#include "InitialTrafficLightStrategies.h"
+#include "NaiveStreetDataStructure.h"
+#include "NullRoutine.h"
+#include "OptimizationRoutine.h"
+#include "Simulator.h"
+#include "TrafficLightRoutine.h"
+#include <../../snowhouse/snowhouse.h>
+
+using namespace snowhouse;
+
+/*
+ * Test if OptimizationRoutine determines the same potential travel distances and green light requests as the original
+ * computation, which determined the potential travel distance of the incoming streets separately for each junction and
+ * stored the requested direction of each junction in every step.
+ */
+
+template <template <typename Vehicle> typename RfbStructure>
+bool isInReferenceTrafficLightZone(const SimulationData<RfbStructure> &data, double distance, unsigned streetId) {
+  const double trafficLightPosition = data.getStreet(streetId).getTrafficLightPosition();
+  return trafficLightPosition - 10.0 * data.getDomainModel().getStreet(streetId).getSpeedLimit() <= distance;
+}
+
+template <template <typename Vehicle> typename RfbStructure>
+double referencePotentialTravelDistance(
+    const SimulationData<RfbStructure> &data, unsigned streetId, rfbstructure_reversible_sorted_iterator_tag) {
+  double potentialTravelDistance = 0;
+  const Street &street           = data.getDomainModel().getStreet(streetId);
+  std::vector<double> contextualVelocity(street.getLanes(), street.getSpeedLimit());
+
+  auto streetIterable = data.getStreet(streetId).getUnderlyingDataStructure().allIterable();
+  for (auto carIt = streetIterable.rbegin(); carIt != streetIterable.rend(); ++carIt) {
+    if (!isInReferenceTrafficLightZone(data, carIt->getDistance(), streetId)) { break; }
+    unsigned lane            = carIt->getLane();
+    contextualVelocity[lane] = std::min(carIt->getTargetVelocity(), contextualVelocity[lane]);
+    potentialTravelDistance += std::max(carIt->getNextVelocity(), contextualVelocity[lane]);
+  }
+  return potentialTravelDistance;
+}
+
+template <template <typename Vehicle> typename RfbStructure>
+double referencePotentialTravelDistance(
+    const SimulationData<RfbStructure> &data, unsigned streetId, rfbstructure_buckets_tag) {
+  double potentialTravelDistance = 0;
+  const Street &street           = data.getDomainModel().getStreet(streetId);
+
+  auto rfb = data.getStreet(streetId).getUnderlyingDataStructure();
+  for (unsigned lane = 0; lane < street.getLanes(); ++lane) {
+    double contextualVelocity = street.getSpeedLimit();
+    double currentDistance    = data.getStreet(streetId).getLength();
+    for (int section = rfb.getSectionCount() - 1; section >= 0; --section) {
+      auto bucket = rfb.getBucket(section, lane);
+      currentDistance -= rfb.getSectionLength();
+      if (!isInReferenceTrafficLightZone(data, currentDistance, streetId)) { break; }
+      for (auto car : bucket) { contextualVelocity = std::min(contextualVelocity, car.getTargetVelocity()); }
+      for (auto car : bucket) { potentialTravelDistance += std::max(car.getNextVelocity(), contextualVelocity); }
+    }
+  }
+  return potentialTravelDistance;
+}
+
+/*
+ * Wraps OptimizationRoutine and compares its results to the reference computation after each step.
+ */
+template <template <typename Vehicle> typename RfbStructure>
+class CheckedOptimizationRoutine {
+  using reverse_category = typename rfbstructure_traits<RfbStructure>::reverse_category;
+
+  SimulationData<RfbStructure> &data;
+
+public:
+  OptimizationRoutine<RfbStructure> routine;
+  // the requested direction of each junction in each step
+  std::vector<std::vector<CardinalDirection>> requestedDirections;
+  double maxPotentialTravelDistance = 0;
+
+  CheckedOptimizationRoutine(SimulationData<RfbStructure> &_data)
+      : data(_data), routine(_data), requestedDirections(data.getDomainModel().getJunctions().size()) {}
+
+  void perform() {
+    routine.perform();
+    for (const auto &junction : data.getDomainModel().getJunctions()) {
+      double maxJunctionPotentialTravelDistance = -1.0;
+      CardinalDirection requestedDirection      = NORTH;
+      for (const auto &street : junction.getIncomingStreets()) {
+        if (!street.isConnected()) { continue; }
+        const unsigned streetId = street.getStreet()->getId();
+        const double potentialTravelDistance = referencePotentialTravelDistance(data, streetId, reverse_category());
+        AssertThat(routine.getPotentialTravelDistance(streetId), Is().EqualTo(potentialTravelDistance));
+        maxPotentialTravelDistance = std::max(maxPotentialTravelDistance, potentialTravelDistance);
+        if (potentialTravelDistance > maxJunctionPotentialTravelDistance) {
+          maxJunctionPotentialTravelDistance = potentialTravelDistance;
+          requestedDirection                 = street.getDirection();
+        }
+      }
+      requestedDirections[junction.getId()].push_back(requestedDirection);
+    }
+  }
+
+  void improveTrafficLights() { routine.improveTrafficLights(); }
+};
+
+template <template <typename Vehicle> typename RfbStructure,
+    template <template <typename Vehicle> typename _RfbStructure> typename ConsistencyRoutineType>
+void checkOptimizationRoutine(const unsigned stepCount, const unsigned carCount) {
+  DomainModel model;
+  createOptimizationTestModel(model, carCount);
+  InitialTrafficLightsAllFive()(model);
+  Simulator<RfbStructure, TrafficLightRoutine, IDMRoutine, CheckedOptimizationRoutine, ConsistencyRoutineType>
+      simulator(model);
+  simulator.performSteps(stepCount);
+
+  const auto &checked = simulator.getOptimizationRoutine();
+  AssertThat(checked.maxPotentialTravelDistance > 0, Is().True());
+  AssertThat(checked.routine.getPerformedSteps(), Is().EqualTo(stepCount));
+  for (const auto &junction : model.getJunctions()) {
+    std::array<unsigned, 4> expectedRequests{};
+    for (const CardinalDirection direction : checked.requestedDirections[junction.getId()]) {
+      ++expectedRequests[direction];
+    }
+    for (unsigned direction = 0; direction < 4; ++direction) {
+      AssertThat(checked.routine.getRequestedGreenLights(junction.getId())[direction],
+          Is().EqualTo(expectedRequests[direction]));
+    }
+  }
+}
+
+void optimizationRoutineTest() { checkOptimizationRoutine<NaiveStreetDataStructure, ConsistencyRoutine>(100, 60); }
+
+// the bucket lists are not simulated with consistency, i.e. the cars stay at their initial positions. The section
+// length shrinks with the number of cars, enough cars are required for sections within the traffic light zone.
+void optimizationRoutineBucketsTest() { checkOptimizationRoutine<VectorBucketList, NullRoutine>(3, 240); }
+
+#endif
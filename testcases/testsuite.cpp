@@ -5,8 +5,18 @@
 #include "domainmodel/DomainModelTest.h"
 #include "domainmodel/JunctionTest.h"
 #include "domainmodel/VehicleTest.h"
+#include "inputoutput/BinaryScenarioReaderTest.h"
+#include "inputoutput/CheckpointTest.h"
+#include "inputoutput/JSONReaderTest.h"
+#include "inputoutput/TrajectoryWriterTest.h"
 #include "lowlevelmodel/RfbStructureTest.h"
+#include "optimization/HeuristicSimulatorTest.h"
+#include "optimization/InitialTrafficLightStrategiesTest.h"
+#include "optimization/OptimizerTest.h"
+#include "optimization/RegionalDecompositionTest.h"
+#include "optimization/TrafficLightCrossingUtilsTest.h"
 #include "routines/ConsistencyRoutineTest.h"
+#include "routines/OptimizationRoutineTest.h"
 #include "routines/ParallelTrafficLightRoutineTest.h"
 #include <../../snowhouse/snowhouse.h>
 #include <iostream>
@@ -47,6 +57,7 @@ int main() {
   // Vehicle:
   RUN(nextDirectionTest);
   RUN(setPositionTest);
+  RUN(updatePositionTest);
   // Junction:
   RUN(junctionCreationTest);
   RUN(trafficLightTest);
@@ -57,11 +68,42 @@ int main() {
   RUN(modelCreationTest);
   RUN(modelCreationTest2);
   RUN(resetAllVehiclesTest);
+  RUN(copyModelTest);
+  RUN(elementStorageTest);
+  // BinaryScenarioReader:
+  RUN(binaryScenarioRoundTripTest);
+  RUN(binaryScenarioInvalidInputTest);
+  // Checkpoint:
+  RUN(checkpointResumeTest<NaiveStreetDataStructure>);
+  RUN(checkpointResumeTest<VectorBucketList>);
+  RUN(checkpointInvalidCarTest);
+  // JSONReader:
+  RUN(jsonReaderSignalsTest);
+  RUN(jsonReaderTypesTest);
+  // TrajectoryWriter:
+  RUN(trajectoryWriterLastFrameTest);
   // Routines:
   RUN(trafficLightRoutineTest);
   RUN(parallelTrafficLightRoutineTest);
   RUN(takeTurnTest);
   RUN(calculateOriginDirectionTest);
+  RUN(routingTableTest);
+  RUN(optimizationRoutineTest);
+  RUN(optimizationRoutineBucketsTest);
+  // Optimizer:
+  RUN(heuristicSimulatorDeadEndTest);
+  RUN(heuristicSimulatorRouteSpeedLimitTest);
+  RUN(cycleTrafficLightRatingTest);
+  RUN(orderSearchTest);
+  RUN(orderSearchPruningTest);
+  RUN(maxReachableVelocityTest);
+  RUN(regionalDecompositionTest);
+  RUN(optimizerTest<OptimizationRoutine>);
+  RUN(optimizerTest<RandomOptimizationRoutine>);
+  RUN(optimizerTest<AnnealingOptimizationRoutine>);
+  RUN(optimizerTest<RegionalOptimizationRoutine>);
+  RUN(optimizerFidelityLevelsTest);
+  RUN(fidelityLevelCountTest);
 
   // RfbStructure - BucketList
   std::cout << "\n   VectorBucketList\n";
@@ -80,6 +122,7 @@ int main() {
   RUN(getNextCarTest3<VectorBucketList>);
   RUN(getNextCarTest4<VectorBucketList>);
   RUN(getNextCarTest5<VectorBucketList>);
+  RUN(getNextCarTest6<VectorBucketList>);
   std::cout << "\n";
   RUN(insertCarTest1<VectorBucketList>);
   RUN(insertCarTest2<VectorBucketList>);
@@ -116,6 +159,7 @@ int main() {
   RUN(getNextCarTest3<FreeListBucketList>);
   RUN(getNextCarTest4<FreeListBucketList>);
   RUN(getNextCarTest5<FreeListBucketList>);
+  RUN(getNextCarTest6<FreeListBucketList>);
   std::cout << "\n";
   RUN(insertCarTest1<FreeListBucketList>);
   RUN(insertCarTest2<FreeListBucketList>);
@@ -153,6 +197,7 @@ int main() {
   RUN(getNextCarTest3<NaiveStreetDataStructure>);
   RUN(getNextCarTest4<NaiveStreetDataStructure>);
   RUN(getNextCarTest5<NaiveStreetDataStructure>);
+  RUN(getNextCarTest6<NaiveStreetDataStructure>);
   std::cout << "\n";
   RUN(insertCarTest1<NaiveStreetDataStructure>);
   RUN(insertCarTest2<NaiveStreetDataStructure>);
@@ -190,6 +235,7 @@ int main() {
   RUN(getNextCarTest3<CircularNaiveStreetDataStructure>);
   RUN(getNextCarTest4<CircularNaiveStreetDataStructure>);
   RUN(getNextCarTest5<CircularNaiveStreetDataStructure>);
+  RUN(getNextCarTest6<CircularNaiveStreetDataStructure>);
   std::cout << "\n";
   RUN(insertCarTest1<CircularNaiveStreetDataStructure>);
   RUN(insertCarTest2<CircularNaiveStreetDataStructure>);
@@ -227,6 +273,7 @@ int main() {
   RUN(getNextCarTest3<MergeNSkipCircular>);
   RUN(getNextCarTest4<MergeNSkipCircular>);
   RUN(getNextCarTest5<MergeNSkipCircular>);
+  RUN(getNextCarTest6<MergeNSkipCircular>);
   std::cout << "\n";
   RUN(insertCarTest1<MergeNSkipCircular>);
   RUN(insertCarTest2<MergeNSkipCircular>);
@@ -264,6 +311,7 @@ int main() {
   RUN(getNextCarTest3<MergeNSkipLinear>);
   RUN(getNextCarTest4<MergeNSkipLinear>);
   RUN(getNextCarTest5<MergeNSkipLinear>);
+  RUN(getNextCarTest6<MergeNSkipLinear>);
   std::cout << "\n";
   RUN(insertCarTest1<MergeNSkipLinear>);
   RUN(insertCarTest2<MergeNSkipLinear>);
@@ -0,0 +1,87 @@
+
+import argparse
+import json
+import struct
+import sys
+
+
+parser = argparse.ArgumentParser(
+    description = 'Converts a trajectory written by traffic_sim --trajectory '
+                  'into one output file per recorded time step in the JSON '
+                  'output format of traffic_sim.',
+)
+parser.add_argument(
+    'input_path',
+    metavar = 'input-path',
+    type = str,
+    help = 'Path to the trajectory file. If the special value "-" is passed, '
+           'the trajectory is read from stdin.',
+)
+parser.add_argument(
+    '--output-path',
+    help = 'Path to which output files are written. '
+           'If this is not specified, ".t_{t}.json" is appended to the input '
+           'path. '
+           'Variables available for substitution: '
+           '{t} the time step of the output file.',
+)
+
+MAGIC = b'\x89TSIMT\n\x1a'
+VERSION = 1
+TRAJECTORY_HEADER = struct.Struct('<8sIIII')
+FRAME_HEADER = struct.Struct('<II')
+VEHICLE_POSITION = struct.Struct('<iiiId')
+
+
+def read_frames(data):
+    magic, version, _, interval, _ = TRAJECTORY_HEADER.unpack_from(data, 0)
+    if magic != MAGIC or version != VERSION:
+        raise ValueError('The input is not a trajectory of version {}.'.format(VERSION))
+
+    offset = TRAJECTORY_HEADER.size
+    while offset < len(data):
+        step, vehicle_count = FRAME_HEADER.unpack_from(data, offset)
+        offset += FRAME_HEADER.size
+
+        cars = []
+        for _ in range(vehicle_count):
+            id, from_junction, to_junction, lane, position = VEHICLE_POSITION.unpack_from(data, offset)
+            offset += VEHICLE_POSITION.size
+            cars.append({
+                'id': id,
+                'from': from_junction,
+                'to': to_junction,
+                'lane': lane,
+                'position': position,
+            })
+        cars.sort(key = lambda car: car['id'])
+
+        yield step, cars
+
+
+def main():
+    args = parser.parse_args()
+
+    if args.output_path is not None and "{t}" not in args.output_path:
+        print(
+            "The output path must contain the variable {t}.",
+            file = sys.stderr,
+        )
+        sys.exit(1)
+
+    if args.output_path is None:
+        args.output_path = args.input_path + ".t_{t}.json"
+
+    if args.input_path == "-":
+        data = sys.stdin.buffer.read()
+    else:
+        with open(args.input_path, 'rb') as f:
+            data = f.read()
+
+    for step, cars in read_frames(data):
+        with open(args.output_path.format(t=step), 'w') as f:
+            json.dump({'cars': cars}, f, sort_keys = True)
+
+
+if __name__ == '__main__':
+    main()